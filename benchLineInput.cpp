@@ -0,0 +1,123 @@
+// benchLineInput.cpp
+
+/*===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE                          
+*               National Center for Biotechnology Information
+*                                                                          
+*  This software/database is a "United States Government Work" under the   
+*  terms of the United States Copyright Act.  It was written as part of    
+*  the author's official duties as a United States Government employee and 
+*  thus cannot be copyrighted.  This software/database is freely available 
+*  to the public for use. The National Library of Medicine and the U.S.    
+*  Government have not placed any restriction on its use or reproduction.  
+*                                                                          
+*  Although all reasonable efforts have been taken to ensure the accuracy  
+*  and reliability of the software and data, the NLM and the U.S.          
+*  Government do not and cannot warrant the performance or results that    
+*  may be obtained by using this software or data. The NLM and the U.S.    
+*  Government disclaim all warranties, express or implied, including       
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.                                                                
+*                                                                          
+*  Please cite the author in any work or product based on this material.   
+*
+* ===========================================================================
+*
+* Author: Vyacheslav Brover
+* Author: Vyacheslav Brover
+*
+* File Description:
+*   Benchmark of LineInput
+*
+*/
+
+
+#undef NDEBUG
+
+#include "common.hpp"
+using namespace Common_sp;
+#include "version.inc"
+
+#include "common.inc"
+
+
+
+namespace 
+{
+  
+  
+  
+struct ThisApplication : Application
+{
+  ThisApplication ()
+    : Application ("Benchmark of reading a file by LineInput: stream, memory-mapped with a line copy, memory-mapped without a line copy.\nPrint: <method> <sec.> <# lines> <# characters>")
+    {
+      version = VERSION;
+      addPositional ("in", "Text file");
+    }
+
+
+
+	void body () const final
+	{
+	  const string in = getArg ("in");
+	  
+	  
+	  size_t lines_prev = no_index;
+	  size_t chars_prev = no_index;
+	  const ONumber on (cout, 3, false);  // PAR
+	  for (const string method : {"stream", "mapped_line", "mapped_view"})
+	  {
+      size_t lines = 0;
+      size_t chars = 0;
+	    const auto start = chrono::steady_clock::now ();
+	    if (method == "stream")
+	    {
+	      IFStream ifs (in);
+  	    LineInput f (ifs);
+  	    while (f. nextLine ())
+  	    {
+  	      lines++;
+  	      chars += f. line. size ();
+  	    }
+	    }
+	    else
+	    {
+  	    LineInput f (in);
+  	    if (method == "mapped_line")
+    	    while (f. nextLine ())
+    	    {
+    	      lines++;
+    	      chars += f. line. size ();
+    	    }
+    	  else
+    	    while (f. nextLineView ())
+    	    {
+    	      lines++;
+    	      chars += f. lineView. size ();
+    	    }
+	    }
+      const double t = chrono::duration<double> (chrono::steady_clock::now () - start). count ();
+      cout << method << '\t' << t << '\t' << lines << '\t' << chars << endl;
+      if (lines_prev != no_index && (lines != lines_prev || chars != chars_prev))
+        throw runtime_error ("Different reading results");
+      lines_prev = lines;
+      chars_prev = chars;
+	  }
+  }  
+};
+
+
+
+}  // namespace
+
+
+
+
+int main (int argc, 
+          const char* argv[])
+{
+  ThisApplication app;
+  return app. run (argc, argv);
+}
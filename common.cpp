@@ -48,6 +48,8 @@
 	  #include <sys/stat.h>
 	  #include <unistd.h>
 	  #include <dirent.h>
+	  #include <fcntl.h>
+	  #include <sys/mman.h>
 	  #ifdef __APPLE__
 	    #include <sys/sysctl.h>
 	  #endif
@@ -2231,35 +2233,115 @@ void Input::reset ()
 
 // LineInput
 
-bool LineInput::nextLine ()
+LineInput::LineInput (const string &fName,
+                      uint displayPeriod)
+: Input (displayPeriod)
+{
+#ifndef _MSC_VER
+  if (getFiletype (fName, true) == Filetype::file)
+    try 
+    { 
+      mapped. reset (new MappedFile (fName, true));
+      if (! mapped->size)  // E.g., /proc/
+        mapped. reset ();
+    }
+    catch (const exception &)  // E.g., /sys/
+      { mapped. reset (); }
+  if (! mapped)
+#endif
+    open (fName);
+}
+
+
+
+void LineInput::reset ()
+{
+#ifndef _MSC_VER
+  if (mapped)
+  {
+    mappedPos = 0;
+    prog. reset ();
+    return;
+  }
+#endif
+  Input::reset ();
+}
+
+
+
+bool LineInput::nextLine_ (bool copy)
 { 
+#ifndef _MSC_VER
+  ASSERT (is || mapped);
+#else
   ASSERT (is);
+#endif
 
 	if (eof)  
 	{ 
 		line. clear ();
+		lineView = string_view ();
 	  return false;
 	}
 	
   try 
 	{
-    getline (*is, line);  // faster than readLine(*is,line)
-
-		eof = is->eof ();
-		if (! eof)
-			lineNum++;
-        
-  	const bool end = line. empty () && eof;
-
-    if (! commentStart. empty ())
-    {
-      const size_t pos = line. find (commentStart);
-      if (pos != string::npos)
-        line. erase (pos);
+	  bool end = false;
+	#ifndef _MSC_VER
+	  if (mapped)
+	  {
+	    // Same as getline()
+	    ASSERT (mappedPos <= mapped->size);
+	    const char* start = mapped->data + mappedPos;
+	    const size_t rest = mapped->size - mappedPos;
+	    // memchr() is vectorized
+	    if (const char* newLine = static_cast <const char*> (memchr (start, '\n', rest)))
+	    {
+	      lineView = string_view (start, (size_t) (newLine - start));
+	      mappedPos += lineView. size () + 1;
+	      lineNum++;
+	    }
+	    else
+	    {
+	      lineView = string_view (start, rest);
+	      mappedPos = mapped->size;
+	      eof = true;
+	    }
+	    end = lineView. empty () && eof;
+      if (! commentStart. empty ())
+      {
+        const size_t pos = lineView. find (commentStart);
+        if (pos != string_view::npos)
+          lineView. remove_suffix (lineView. size () - pos);
+      }
+      if (copy)
+      {
+        line. assign (lineView);
+        lineView = line;
+      }
+	  }
+	  else
+	#endif
+	  {
+      getline (*is, line);  // faster than readLine(*is,line)
+  
+  		eof = is->eof ();
+  		if (! eof)
+  			lineNum++;
+          
+    	end = line. empty () && eof;
+  
+      if (! commentStart. empty ())
+      {
+        const size_t pos = line. find (commentStart);
+        if (pos != string::npos)
+          line. erase (pos);
+      }
+    //trimTrailing (line); 
+      lineView = line;
     }
-  //trimTrailing (line); 
 
-  	if (! end)
+  	if (! end && prog. active)
   		prog ();
   		
   	return ! end;
@@ -2950,6 +3032,55 @@ void OFStream::open (const string &dirName,
 
 
 
+// MappedFile
+
+#ifndef _MSC_VER
+MappedFile::MappedFile (const string &fName_arg,
+                        bool sequential)
+: fName (fName_arg)
+{
+  if (getFiletype (fName, true) != Filetype::file)
+    throw runtime_error ("Cannot open file " + shellQuote (fName));
+
+  fd = open (fName. c_str (), O_RDONLY);
+  if (fd == -1)
+    throw runtime_error ("Cannot open file " + shellQuote (fName));
+
+  struct stat buf;
+  if (fstat (fd, & buf))
+  {
+    close (fd);
+    throw runtime_error ("Cannot get the size of file " + shellQuote (fName));
+  }
+  size = (size_t) buf. st_size;
+  if (! size)
+    return;
+
+  void* p = mmap (nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (p == MAP_FAILED)
+  {
+    close (fd);
+    throw runtime_error ("Cannot memory-map file " + shellQuote (fName));
+  }
+  data = static_cast <const char*> (p);
+  if (sequential)
+    madvise (p, size, MADV_SEQUENTIAL);
+}
+
+
+
+MappedFile::~MappedFile ()
+{
+  if (data)
+    munmap (var_cast (data), size);
+  if (fd != -1)
+    close (fd);
+}
+#endif
+
+
+
+
 // PairFile
 
 bool PairFile::next ()
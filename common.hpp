@@ -62,6 +62,7 @@
 #include <cstring>
 #include <cmath>
 #include <string>
+#include <string_view>
 #include <stdexcept>
 #include <limits>
 #include <array>
@@ -81,6 +82,7 @@
 #include <filesystem>
 
 #include <thread>
+#include <atomic>
 #ifdef _MSC_VER
 	#pragma warning(push)
 	#pragma warning(disable:4265)
@@ -1750,6 +1752,51 @@ struct OFStream : ofstream
 
 
 
+#ifndef _MSC_VER
+struct MappedFile : Nocopy
+// Read-only memory-mapped file
+// File content is platform-dependent if it was written by writeBin()
+{
+  const string fName;
+private:
+  int fd {-1};
+public:
+  const char* data {nullptr};
+    // nullptr <=> !size
+  size_t size {0};
+
+
+  explicit MappedFile (const string &fName_arg,
+                       bool sequential = false);
+ ~MappedFile ();
+
+
+  template <typename T>
+    void readBin (size_t &pos,
+                  T &t) const
+      { if (pos + sizeof (t) > size)
+          throw runtime_error ("File " + shellQuote (fName) + " is truncated at position " + to_string (pos));
+        memcpy (& t, data + pos, sizeof (t));
+        pos += sizeof (t);
+      }
+    // Update: pos
+  template <typename T>
+    const T* getArray (size_t pos) const
+      { if (pos % alignof (T))
+          throw runtime_error ("File " + shellQuote (fName) + " is not aligned at position " + to_string (pos));
+        return static_cast <const T*> (static_cast <const void*> (data + pos));
+      }
+    // data is page-aligned
+    // Return: array of T's starting at pos, read in place
+  bool startsWith (const string &prefix) const
+    { return    size >= prefix. size ()
+             && ! memcmp (data, prefix. c_str (), prefix. size ());
+    }
+};
+#endif
+
+
+
 struct Cout : Singleton<Cout>
 {
   unique_ptr<OFStream> f;
@@ -3819,6 +3866,14 @@ protected:
     {}
   Input (istream &is_arg,
 	       uint displayPeriod);
+  explicit Input (uint displayPeriod)
+    : prog (0, displayPeriod)  
+    {}
+    // Requires: open()
+  void open (const string &fName)
+    { ifs = IFStream (fName);
+      is = & ifs;
+    }
 public:
 
 
@@ -3833,21 +3888,41 @@ struct LineInput : Input
 	  // Number of lines read
 	string line;
 	  // Current line
+	string_view lineView;
+	  // Current line
+	  // Valid until the next reading
+	  // = line if nextLine()
   string commentStart;
+private:
+#ifndef _MSC_VER
+  unique_ptr<MappedFile> mapped;
+    // nullptr => *is is read
+  size_t mappedPos {0};
+#endif
+public:
 
 	
 	explicit LineInput (const string &fName,
-          	          uint displayPeriod = 0)
-    : Input (fName, displayPeriod)
-    {}
+          	          uint displayPeriod = 0);
+    // A regular non-empty file is memory-mapped, otherwise it is opened as a stream
+    // If a memory-mapped file is truncated by another process while being read then SIGBUS is raised (getline() would see EOF)
   explicit LineInput (istream &is_arg,
 	                    uint displayPeriod = 0)
     : Input (is_arg, displayPeriod)
     {}
 
 
-	bool nextLine ();
-  	// Output: line
+  void reset ();
+	bool nextLine ()
+	  { return nextLine_ (true); }
+  	// Output: line, lineView
+	bool nextLineView ()
+	  { return nextLine_ (false); }
+  	// Output: lineView
+  	// line is not changed if the file is memory-mapped
+private:
+  bool nextLine_ (bool copy);
+public:
 	bool expectPrefix (const string &prefix,
 	                   bool eofAllowed)
 		{ if (nextLine () && trimPrefix (line, prefix))
@@ -3860,6 +3935,159 @@ struct LineInput : Input
 	string lineStr (bool add1 = true) const
 	  { return "line " + to_string (lineNum + add1); }
 };
+
+
+
+struct LinesChunk
+// Part of a file for parseLines()
+{
+  size_t lines {0};
+  size_t offset {0};
+    // In parseLines()::items
+  size_t items {0};
+    // Parsed: parseLines()::items[offset, offset + items)
+  string error;
+    // Of the line lines + 1
+    // !empty() => parsing is stopped
+};
+  
+
+
+template <typename T, typename Func>
+  size_t parseLines (const string &fName,
+                     const Func &parse,
+                     Vector<T> &items,
+                     size_t displayPeriod = 0)
+  // Input: bool parse (string_view line, T &item): false <=> line is skipped; may throw
+  //        line: as in LineInput::nextLine()
+  //        displayPeriod: of Progress by lines; 0 <=> no Progress
+  // Output: items: in the order of lines
+  // Return: # lines
+  // Threads: a memory-mapped fName is split at line ends into threads_max chunks which are parsed in parallel
+  // Memory: items are parsed in place, the size of items is at most the # lines
+  {
+    items. clear ();
+    const auto lineError = [&fName] (size_t lineNum, const string &error)
+      { return runtime_error ("File " + shellQuote (fName) + ", line " + to_string (lineNum) + ": " + error); };
+  #ifndef _MSC_VER
+    unique_ptr<MappedFile> mapped;
+    if (getFiletype (fName, true) == Filetype::file)
+      try { mapped. reset (new MappedFile (fName, true)); }
+        catch (const exception &) {}
+    if (mapped && mapped->size)
+    {
+      const char* data = mapped->data;
+      const size_t size = mapped->size;
+      // Chunk i: [starts[i], starts[i+1])
+      Vector<size_t> starts;  starts. reserve (threads_max + 1);
+      starts << 0;
+      for (size_t i = 1; i < threads_max; i++)
+      {
+        const size_t pos = max (starts. back (), size / threads_max * i);
+        if (pos >= size)
+          break;
+        const char* newLine = static_cast <const char*> (memchr (data + pos, '\n', size - pos));
+        if (! newLine)
+          break;
+        const size_t start = (size_t) (newLine - data) + 1;
+        if (start > starts. back ())
+          starts << start;
+      }
+      starts << size;
+      Vector<LinesChunk> chunks (starts. size () - 1);
+      vector<Notype> notypes;
+      // LinesChunk::lines
+      arrayThreads (true, [data, &starts, &chunks] (size_t from, size_t to, Notype &/*res*/)
+                            { for (size_t i = from; i < to; i++)
+                              { const char* p   = data + starts [i];
+                                const char* end = data + starts [i + 1];
+                                LinesChunk& chunk = chunks [i];
+                                chunk. lines = (size_t) std::count (p, end, '\n');
+                                if (p < end && end [-1] != '\n')
+                                  chunk. lines++;
+                              }
+                            }
+                   , chunks. size (), notypes);
+      size_t lines = 0;
+      for (LinesChunk& chunk : chunks)
+      {
+        chunk. offset = lines;
+        lines += chunk. lines;
+      }
+      items. resize (lines);
+      atomic<size_t> linesDone (0);
+      Progress prog (lines, displayPeriod);
+      arrayThreads (true, [data, &starts, &chunks, &parse, &items, &linesDone, &prog] (size_t from, size_t to, Notype &/*res*/)
+                            { constexpr size_t progressStep = 1024;  // PAR
+                              const bool main = isMainThread ();
+                              for (size_t i = from; i < to; i++)
+                              { const char* p   = data + starts [i];
+                                const char* end = data + starts [i + 1];
+                                LinesChunk& chunk = chunks [i];
+                                size_t parsed = 0;
+                                while (p < end)
+                                { const char* newLine = static_cast <const char*> (memchr (p, '\n', (size_t) (end - p)));
+                                  if (! newLine)
+                                    newLine = end;
+                                  try 
+                                  { if (parse (string_view (p, (size_t) (newLine - p)), items [chunk. offset + chunk. items]))
+                                      chunk. items++;
+                                  }
+                                  catch (const exception &e)
+                                  { chunk. lines = parsed;
+                                    chunk. error = e. what ();
+                                    return;
+                                  }
+                                  parsed++;
+                                  if (parsed % progressStep == 0)
+                                  { linesDone += progressStep;
+                                    if (main)
+                                      while (prog. n < linesDone)
+                                        prog ();
+                                  }
+                                  p = newLine + 1;
+                                }
+                              }
+                            }
+                   , chunks. size (), notypes);
+      lines = 0;
+      for (const LinesChunk& chunk : chunks)
+      {
+        if (! chunk. error. empty ())
+          throw lineError (lines + chunk. lines + 1, chunk. error);
+        lines += chunk. lines;
+      }
+      if (displayPeriod)
+        while (prog. n < lines)
+          prog ();
+      // Removing the gaps of skipped lines
+      size_t n = 0;
+      for (const LinesChunk& chunk : chunks)
+      {
+        if (n != chunk. offset)
+          for (size_t i = 0; i < chunk. items; i++)
+            items [n + i] = std::move (items [chunk. offset + i]);
+        n += chunk. items;
+      }
+      items. resize (n);
+      return lines;
+    }
+  #endif
+    LineInput f (fName, (uint) displayPeriod);
+    size_t lines = 0;
+    T item;
+    while (f. nextLineView ())
+    {
+      try 
+      { if (parse (f. lineView, item))
+          items << std::move (item);
+      }
+      catch (const exception &e)
+        { throw lineError (lines + 1, e. what ()); }
+      lines++;
+    }
+    return lines;
+  }
 	
 
 
@@ -116,6 +116,7 @@ struct ThisApplication : Application
       dist = attr->asPositiveAttr2 ();
     }
     QC_ASSERT (dist);
+    var_cast (dist) -> unpack ();
     
     
     Vector<size_t> objs (ds. objs. size (), no_index);
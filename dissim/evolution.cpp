@@ -62,7 +62,7 @@ Real maps2dissim (Real size1,
   ASSERT (isProb (sizes_ratio_min));
   
   
-  if (verbose ())
+  if (verbose () && isMainThread ())  // Output of other threads would interleave
     cout << '\t' << maps1 
          << '\t' << maps2
          << '\t' << size1 
@@ -98,10 +98,121 @@ Real maps2dissim (Real size1,
 
 
 
+size_t hashesIntersectionSize (const size_t* hashes1,
+                               size_t size1,
+                               const size_t* hashes2,
+                               size_t size2,
+                               size_t intersection_min)
+{
+  size_t n = 0;
+  size_t i = 0;
+  size_t j = 0;
+  
+  // The largest hash of a block decides which block is finished
+  while (i + 4 <= size1 && j + 4 <= size2)
+  {
+    if (n + min (size1 - i, size2 - j) < intersection_min)
+      return n;
+    const size_t* a = hashes1 + i;
+    const size_t* b = hashes2 + j;
+    size_t c = 0;
+    FOR (size_t, k, 4)
+      c +=   (size_t) (a [k] == b [0])
+           + (size_t) (a [k] == b [1])
+           + (size_t) (a [k] == b [2])
+           + (size_t) (a [k] == b [3]);
+    n += c;
+    const size_t a_last = a [3];
+    const size_t b_last = b [3];
+    i += 4 * (size_t) (a_last <= b_last);
+    j += 4 * (size_t) (b_last <= a_last);
+  }
+  
+  while (i < size1 && j < size2)
+    if (hashes1 [i] < hashes2 [j])
+      i++;
+    else if (hashes2 [j] < hashes1 [i])
+      j++;
+    else
+    {
+      n++;
+      i++;
+      j++;
+    }
+    
+  return n;
+}
+
+
+
+Real hashes2dissim (const size_t* hashes1,
+                    size_t size1,
+                    const size_t* hashes2,
+                    size_t size2,
+                    size_t intersection_min,
+                    Prob hashes_ratio_min)
+{
+  // Cf. maps2dissim()
+  const size_t size_max = max (size1, size2);
+  if (! size_max)
+    return NaN;
+  if ((Real) min (size1, size2) / (Real) size_max < hashes_ratio_min)
+    return NaN;
+    
+  const size_t intersection = hashesIntersectionSize (hashes1, size1, hashes2, size2, intersection_min);
+  if (intersection < intersection_min)
+    return NaN;
+    
+  return intersection2dissim ( (Real) size1
+                             , (Real) size2
+                             , (Real) intersection
+                             , (Real) intersection_min
+                             , hashes_ratio_min
+                             , true  // PAR
+                             ); 
+}
+
+
+
+
 // Hashes
 
+namespace
+{
+  
+constexpr uint32_t hashesBin_version = 1;
+const string hashesBin_magic ("Hashes.bin");
+
+
+struct HashesBinHeader
+{
+  char magic [16];
+  uint32_t version {hashesBin_version};
+  uint32_t reserved {0};
+  uint64_t num {0};
+    // # hashes
+  
+  HashesBinHeader ()
+    { memset (magic, 0, sizeof (magic));
+      memcpy (magic, hashesBin_magic. c_str (), hashesBin_magic. size ());
+    }
+};
+
+
+static_assert (sizeof (HashesBinHeader) == 32);
+
+}
+
+
+
 Hashes::Hashes (const string &fName)
 {
+  if (isBinFile (fName))
+  {
+    loadBin (fName);
+    return;
+  }
+  
   reserve (10000);  // PAR
 
   LineInput hf (fName);
@@ -124,7 +235,169 @@ Hashes::Hashes (const string &fName)
 
 
 
-// Read Hashes from a binary file ??
+void Hashes::loadBin (const string &fName)
+{
+#ifndef _MSC_VER
+  const MappedFile mf (fName, true);
+  size_t pos = 0;
+  HashesBinHeader header;
+  mf. readBin (pos, header);
+  if (header. version != hashesBin_version)
+    throw runtime_error (FUNC + strQuote (fName) + ": unsupported binary hash file version " + to_string (header. version));
+    
+  reserve (header. num);
+  const uint8_t* data = reinterpret_cast <const uint8_t*> (mf. data);
+  size_t prev = 0;
+  FOR (uint64_t, i, header. num)
+  {
+    size_t delta = 0;
+    for (uint shift = 0; ; shift += 7)
+    {
+      if (pos == mf. size || shift >= 64)
+        throw runtime_error (FUNC + strQuote (fName) + " is damaged");
+      const uint8_t b = data [pos];
+      pos++;
+      delta |= (size_t) (b & 0x7F) << shift;
+      if (! (b & 0x80))
+        break;
+    }
+    if (! delta)
+      throw runtime_error (FUNC + strQuote (fName) + ": hashes are not increasing");
+    prev += delta;
+    *this << prev;
+  }
+  if (pos != mf. size)
+    throw runtime_error (FUNC + strQuote (fName) + " is damaged");
+  ascending = etrue;
+#else
+  NOT_IMPLEMENTED;
+#endif
+}
+
+
+
+void Hashes::saveBin (const string &fName) const
+{
+  HashesBinHeader header;
+  header. num = size ();
+  
+  string varints;  varints. reserve (3 * size ());  // PAR
+  size_t prev = 0;
+  for (const size_t hash : *this)
+  {
+    if (hash <= prev)
+      throw runtime_error (FUNC "Hash " + to_string (hash) + " is not greater than the previous hash " + to_string (prev));
+    size_t delta = hash - prev;
+    while (delta >= 0x80)
+    {
+      varints += (char) (uint8_t) ((delta & 0x7F) | 0x80);
+      delta >>= 7;
+    }
+    varints += (char) (uint8_t) delta;
+    prev = hash;
+  }
+
+  ofstream f (fName, ios_base::binary | ios_base::out);
+  if (! f. good ())
+    throw runtime_error (FUNC "Cannot create file " + shellQuote (fName));
+  writeBin (f, header);
+  f. write (varints. data (), (streamsize) varints. size ());
+  f. close ();
+  if (! f. good ())
+    throw runtime_error (FUNC "Cannot write file " + shellQuote (fName));
+}
+
+
+
+bool Hashes::isBinFile (const string &fName)
+{
+  ifstream f (fName, ios_base::binary | ios_base::in);
+  if (! f. good ())
+    return false;
+  HashesBinHeader header;
+  readBin (f, header);
+  return    f. good ()
+         && ! strncmp (header. magic, hashesBin_magic. c_str (), sizeof (header. magic));
+}
+
+
+
+
+// HashesCache
+
+shared_ptr<const Hashes> HashesCache::get (const string &fName)
+{
+  {
+    const Lock lock (mtx);
+    const auto it = fName2item. find (fName);
+    if (it != fName2item. end ())
+    {
+      lru. splice (lru. begin (), lru, it->second. lruIt);
+      return it->second. hashes;
+    }
+  }
+  
+  const shared_ptr<const Hashes> hashes (new Hashes (fName));
+
+  const Lock lock (mtx);
+  if (const Item* item = findPtr (fName2item, fName))
+    return item->hashes;  // Loaded by another thread
+  lru. push_front (fName);
+  Item& item = fName2item [fName];
+  item. hashes = hashes;
+  item. lruIt = lru. begin ();
+  hashes_size += hashes->size ();
+  while (hashes_size > hashes_max && lru. size () > 1)
+  {
+    const auto it = fName2item. find (lru. back ());
+    ASSERT (it != fName2item. end ());
+    ASSERT (hashes_size >= it->second. hashes->size ());
+    hashes_size -= it->second. hashes->size ();
+    fName2item. erase (it);
+    lru. pop_back ();
+  }
+
+  return hashes;
+}
+
+
+
+
+// HashArena
+
+Vector<HashArena::Tile> HashArena::getTiles () const
+{
+  const size_t n = size ();
+  const size_t hashes_ave = max<size_t> (1, hashes. size () / max<size_t> (1, n));
+  const size_t side = max<size_t> (1, min (tile_max, tile_bytes / (2 * sizeof (size_t) * hashes_ave)));
+
+  Vector<Tile> tiles;  tiles. reserve (sqr (n / side + 1) / 2 + n / side + 1);
+  for (size_t rowStart = 0; rowStart < n; rowStart += side)
+    for (size_t colStart = 0; colStart <= rowStart; colStart += side)
+    {
+      Tile tile;
+      tile. rowStart = rowStart;
+      tile. rowEnd   = min (n, rowStart + side);
+      tile. colStart = colStart;
+      tile. colEnd   = min (n, colStart + side);
+      tiles << tile;
+    }
+    
+  return tiles;
+}
+
+
+
+void HashArena::getTileDissims (const Tile &tile,
+                                size_t intersection_min,
+                                Prob hashes_ratio_min,
+                                Vector<Real> &dissims) const
+{
+  dissims. clear ();
+  FOR_START (size_t, row, tile. rowStart, tile. rowEnd)
+    FOR_START (size_t, col, tile. colStart, min (tile. colEnd, row))
+      dissims << getDissim (row, col, intersection_min, hashes_ratio_min);
+}
 
 
 
@@ -54,6 +54,7 @@ Real maps2dissim (Real size1,
                   Prob sizes_ratio_min,
                   bool ave_arithP);
   // Input: ave_arithP; false <=> ave_harm()
+  // Output: cout if verbose() and isMainThread()
   // Return: >= 0; may be NaN
 
 inline Real intersection2dissim (Real size1,
@@ -67,28 +68,185 @@ inline Real intersection2dissim (Real size1,
 
 
 
+size_t hashesIntersectionSize (const size_t* hashes1,
+                               size_t size1,
+                               const size_t* hashes2,
+                               size_t size2,
+                               size_t intersection_min);
+  // Return: size of the intersection of hashes1[] and hashes2[] if it is >= intersection_min,
+  //         otherwise a number < intersection_min
+  // Input: hashes1[], hashes2[]: ascending, unique
+  // Blocks of 4x4 hashes are compared without branches
+  // Time: O(size1 + size2)
+
+Real hashes2dissim (const size_t* hashes1,
+                    size_t size1,
+                    const size_t* hashes2,
+                    size_t size2,
+                    size_t intersection_min,
+                    Prob hashes_ratio_min);
+  // Return: = intersection2dissim(size1,size2,<intersection size>,intersection_min,hashes_ratio_min,true), 
+  //           but NaN is returned without computing the intersection if possible
+  // Invokes: hashesIntersectionSize()
+  // Symmetric
+
+
+
 struct Hashes : Vector<size_t>
 // searchSorted
 {
 	explicit Hashes (const string &fName);
+	  // Input: fName: text file with a hash per line, sorted numerically, unique, e.g., fasta2hash output,
+	  //               or a file saved by saveBin()
 	Hashes () = default;
+private:
+  void loadBin (const string &fName);
+public:
+	
+	void saveBin (const string &fName) const;
+	  // Binary format: <header> {<varint of the difference with the previous hash>}*
+	  // Size: ~ 2-3 bytes per hash for dense hashes
+	static bool isBinFile (const string &fName);
 	
 	Real getDissim (const Hashes &other,
 	                size_t intersection_min,
 	                Prob hashes_ratio_min) const
-		{ return intersection2dissim ( (Real) size ()
-			                           , (Real) other. size ()
-			                           , (Real) getIntersectionSize (other)
-			                           , (Real) intersection_min
-			                           , hashes_ratio_min
-			                           , true  // PAR
-			                           ); 
-		}
+		{ return hashes2dissim (data (), size (), other. data (), other. size (), intersection_min, hashes_ratio_min); }
 		// Symmetric
 };
 
 
 
+struct HashesCache : Nocopy
+// LRU cache of Hashes loaded from files
+// Thread-safe
+{
+  const size_t hashes_max;
+    // Max. total number of hashes in the cache
+private:
+  struct Item
+  {
+    shared_ptr<const Hashes> hashes;
+    list<string>::iterator lruIt;
+  };
+  unordered_map<string/*fName*/,Item> fName2item;
+  list<string/*fName*/> lru;
+    // Most recently used first
+  size_t hashes_size {0};
+  std::mutex mtx;
+public:
+
+
+  explicit HashesCache (size_t hashes_max_arg)
+    : hashes_max (hashes_max_arg)
+    {}
+
+
+  shared_ptr<const Hashes> get (const string &fName);
+    // Return: !nullptr
+    // A file is loaded without locking the cache
+};
+
+
+
+struct HashArena
+// Hashes of objects stored in one array
+{
+private:
+  Vector<size_t> hashes;
+  Vector<size_t> starts;
+    // Index in hashes
+    // size() = # objects + 1
+  static constexpr size_t tile_bytes {1 << 20};  // PAR
+    // Hashes of the objects of a tile are in the L2 cache
+  static constexpr size_t tile_max {256};  // PAR
+public:
+
+
+  HashArena ()
+    { starts << 0; }
+    
+    
+  size_t size () const
+    { return starts. size () - 1; }
+  size_t add (const Hashes &h)
+    { hashes. insert (hashes. end (), h. begin (), h. end ());  // Amortized growth
+      starts << hashes. size ();
+      return size () - 1;
+    }
+    // Return: object index
+  size_t getHashesSize (size_t objNum) const
+    { return starts [objNum + 1] - starts [objNum]; }
+  Real getDissim (size_t objNum1,
+                  size_t objNum2,
+                  size_t intersection_min,
+                  Prob hashes_ratio_min) const
+    { return hashes2dissim ( & hashes [starts [objNum1]], getHashesSize (objNum1)
+                           , & hashes [starts [objNum2]], getHashesSize (objNum2)
+                           , intersection_min
+                           , hashes_ratio_min
+                           );
+    }
+    // = Hashes::getDissim()
+  template <typename Put>
+    void getAllDissims (size_t intersection_min,
+                        Prob hashes_ratio_min,
+                        Put &put) const
+      // Invokes: put(row,col,getDissim(row,col,intersection_min,hashes_ratio_min)) for each row > col, from one thread at a time
+      // Threads
+      // Time: O(size()^2 average_hashes_size / threads_max)
+      { Vector<Tile> tiles (getTiles ());
+        std::mutex mtx;
+        vector<Notype> notypes;
+        arrayThreads (false, getAllDissims_array<Put>, tiles. size (), notypes, this, & tiles, intersection_min, hashes_ratio_min, & put, & mtx);
+      }
+private:
+  struct Tile
+  {
+    size_t rowStart {0};
+    size_t rowEnd {0};
+    size_t colStart {0};
+    size_t colEnd {0};
+  };
+  Vector<Tile> getTiles () const;
+    // Return: square tiles of the lower triangle, by rows
+  void getTileDissims (const Tile &tile,
+                       size_t intersection_min,
+                       Prob hashes_ratio_min,
+                       Vector<Real> &dissims) const;
+    // Output: dissims: by rows, for row > col
+  template <typename Put>
+    static void getAllDissims_array (size_t from,
+                                     size_t to,
+                                     Notype /*&res*/,
+                                     const HashArena* arena,
+                                     const Vector<Tile>* tiles,
+                                     size_t intersection_min,
+                                     Prob hashes_ratio_min,
+                                     Put* put,
+                                     std::mutex* mtx)
+      { unique_ptr<Progress> prog;
+        if (isMainThread ())
+          prog. reset (new Progress (to - from));
+        Vector<Real> dissims;
+        for (size_t i = from; i < to; i++)
+        { if (prog. get ())
+            (*prog) ();
+          const Tile& tile = (*tiles) [i];
+          arena->getTileDissims (tile, intersection_min, hashes_ratio_min, dissims);
+          const Lock lock (*mtx);
+          size_t k = 0;
+          for (size_t row = tile. rowStart; row < tile. rowEnd; row++)
+            for (size_t col = tile. colStart; col < min (tile. colEnd, row); col++)
+            { (*put) (row, col, dissims [k]);
+              k++;
+            }
+        }
+      }
+};
+
+
+
 
 // ObjFeature
 
@@ -256,7 +256,7 @@ struct ThisApplication : Application
     Vector<Match> matches;  matches. reserve (seqs. size () * (seqs. size () - 1) / 2);
 	  FFOR (size_t, row, seqs. size ())
 	  {
-	  	dissimAttr->matr. put (false, row, row, 0.0);
+	  	dissimAttr->put (row, row, 0.0);
 	    FFOR_START (size_t, col, row + 1, seqs. size ())
 	      matches << Match (row, col, seqs);
 	  }
@@ -276,7 +276,7 @@ struct ThisApplication : Application
 				     << '\t' << m. self_score2
 				     << endl;
 			else
-			  dissimAttr->matr. putSymmetric (m. row, m. col, m. dissim); 
+			  dissimAttr->putSymm (m. row, m. col, m. dissim); 
     }
 
 		if (! dsFName. empty ())
@@ -58,7 +58,7 @@ const string attrName = "cons";
 struct ThisApplication : Application
 {
   ThisApplication ()
-    : Application ("Convert hashes to a dissimilarity named " + strQuote (attrName) + " and print a " + dmSuff + "-file")
+    : Application ("Convert hashes to a dissimilarity named " + strQuote (attrName) + " and print a " + dmSuff + "-file", true, false, true)
     {
       version = VERSION;
     	// Input
@@ -66,6 +66,7 @@ struct ThisApplication : Application
   	  addPositional ("hash_dir", "Directory with hashes for each object");
   	  addKey ("intersection_min", "Min. number of common hashes to compute distance", "50");
   	  addKey ("ratio_min", "Min. ratio of hash sizes (0..1)", "0.5");
+  	  addFlag ("packed", "Store the dissimilarity as an upper triangle of float's: 1/4 of memory");
   	  // Output
   	  addPositional ("out", "Output " + dmSuff + "-file without " + dmSuff);
   	}
@@ -78,6 +79,7 @@ struct ThisApplication : Application
 		const string hash_dir         = getArg  ("hash_dir");
 		const size_t intersection_min = str2<size_t> (getArg ("intersection_min"));
 		const Prob   hashes_ratio_min = str2real (getArg ("ratio_min"));
+		const bool   packed           = getFlag ("packed");
 		const string out              = getArg ("out");
 		ASSERT (isProb (hashes_ratio_min));
 		ASSERT (! out. empty ());
@@ -101,30 +103,55 @@ struct ThisApplication : Application
     ds. qc ();
     
     
-    Vector<Hashes> obj2hashes;  obj2hashes. reserve (ds. objs. size ());
+    HashArena arena;
+    Vector<Hashes> obj2hashes;
+      // For QC
     {
       Progress prog (ds. objs. size ());
       FFOR (size_t, objNum, ds. objs. size ())
       {
         prog (ds. objs [objNum] -> name);
-        obj2hashes << std::move (Hashes (hash_dir + "/" + ds. objs [objNum] -> name));
+        Hashes hashes (hash_dir + "/" + ds. objs [objNum] -> name);
+        EXEC_ASSERT (arena. add (hashes) == objNum);
+        if (qc_on)
+          obj2hashes << std::move (hashes);
       }
     }
     
+    if (packed)
+      RealAttr2::packedObjs_min = 0;
     auto attr = new PositiveAttr2 (attrName, ds, 6);  // PAR
     {
+      const auto put = [attr] (size_t row, size_t col, Real dissim) { attr->putSymm (row, col, dissim); };
+      arena. getAllDissims (intersection_min, hashes_ratio_min, put);
+      FFOR (size_t, row, ds. objs. size ())
+        attr->put (row, row, 0);
+    }
+    
+    if (qc_on)
+    {
+      // The tiled dissimilarities = the pairwise ones computed by a sequential merge
+      cerr << "QC" << endl;
       Progress prog (ds. objs. size ());
       FFOR (size_t, row, ds. objs. size ())
       {
-        prog (ds. objs [row] -> name);
-        const Hashes& hash1 = obj2hashes [row];
+        prog ();
+        const Hashes& hashes1 = obj2hashes [row];
         FOR (size_t, col, row)
         {
-          const Hashes& hash2 = obj2hashes [col];
-          const Real dissim = hash1. getDissim (hash2, intersection_min, hashes_ratio_min);
-          attr->putSymm (row, col, dissim);
+          const Hashes& hashes2 = obj2hashes [col];
+          const Real dissim = intersection2dissim ( (Real) hashes1. size ()
+                                                  , (Real) hashes2. size ()
+                                                  , (Real) hashes1. getIntersectionSize (hashes2)
+                                                  , (Real) intersection_min
+                                                  , hashes_ratio_min
+                                                  , true  // PAR
+                                                  );
+          if (! sameReal (attr->get (row, col), dissim, packed ? 1e-6 : 0.0))  // PAR
+            throw runtime_error ("Dissimilarity between " + strQuote (ds. objs [row] -> name) + " and " + strQuote (ds. objs [col] -> name) 
+                                 + " is " + toString (attr->get (row, col)) + ", but the pairwise dissimilarity is " + toString (dissim)
+                                );
         }
-        attr->put (row, row, 0);
       }
     }
     
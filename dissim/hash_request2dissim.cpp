@@ -46,18 +46,39 @@ using namespace DM_sp;
 
 namespace 
 {
+  
+  
+void getDissims (size_t from,
+                 size_t to,
+                 Notype /*&res*/,
+                 const Vector<pair<string,string>>* fNamePairs,
+                 HashesCache* cache,
+                 size_t intersection_min,
+                 Prob hashes_ratio_min,
+                 Real* dissims)
+{
+  FOR_START (size_t, i, from, to)
+  {
+    const pair<string,string>& p = (*fNamePairs) [i];
+    const shared_ptr<const Hashes> h1 (cache->get (p. first));
+    const shared_ptr<const Hashes> h2 (cache->get (p. second));
+    dissims [i] = h1->getDissim (*h2, intersection_min, hashes_ratio_min);
+  }
+}
+
 
 
 struct ThisApplication : Application
 {
   ThisApplication ()
-    : Application ("Compute hash dissimilarities for pairs of hash files")
+    : Application ("Compute hash dissimilarities for pairs of hash files", true, false, true)
     {
       version = VERSION;
     	// Input
-  	  addPositional ("pairs", "File with pairs of files");
+  	  addPositional ("pairs", "File with pairs of hash files. Hash files are in the text or binary format, see hash2bin");
   	  addKey ("intersection_min", "Min. number of common hashes to compute distance", "50");
   	  addKey ("ratio_min", "Min. ratio of hash sizes (0..1)", "0.5");
+  	  addKey ("cache_hashes", "Max. number of hashes kept in memory", "100000000");
   	  // Output
   	  addPositional ("out", "Output file with lines: <obj1> <obj2> <dissimlarity>; <obj1> < <obj2>");
   	}
@@ -69,26 +90,38 @@ struct ThisApplication : Application
 		const string pairsFName       = getArg  ("pairs");
 		const size_t intersection_min = str2<size_t> (getArg ("intersection_min"));
 		const Prob   hashes_ratio_min = str2real (getArg ("ratio_min"));
+		const size_t cache_hashes     = str2<size_t> (getArg ("cache_hashes"));
 		const string out              = getArg  ("out");
 		ASSERT (isProb (hashes_ratio_min));
 		ASSERT (! out. empty ());
 		
 		
     // Cf. hash2dissim.cpp
+    constexpr size_t batch_size = 100000;  // PAR
+    HashesCache cache (cache_hashes);
     OFStream output (out);
     ONumber on (output, 6, true);  // PAR
-    map<string/*fName*/,Hashes> name2hashes;
     PairFile input (pairsFName, false, false);
-    while (input. next ())
+    Vector<pair<string,string>> fNamePairs;  fNamePairs. reserve (batch_size);
+    Vector<Real> dissims;
+    bool eof = false;
+    while (! eof)
     {
-      const string fName1 (input. name1);
-      const string fName2 (input. name2);
-      if (! contains (name2hashes, fName1))  name2hashes [fName1] = std::move (Hashes (fName1));
-      if (! contains (name2hashes, fName2))  name2hashes [fName2] = std::move (Hashes (fName2));
-      const Hashes& h1 = name2hashes [fName1];
-      const Hashes& h2 = name2hashes [fName2];
-      const double dissim = h1. getDissim (h2, intersection_min, hashes_ratio_min);
-      output << input. name1 << '\t' << input. name2 << '\t' << dissim << endl;
+      fNamePairs. clear ();
+      while (fNamePairs. size () < batch_size)
+        if (input. next ())
+          fNamePairs << pair<string,string> (input. name1, input. name2);
+        else
+        {
+          eof = true;
+          break;
+        }
+      dissims. clear ();
+      dissims. resize (fNamePairs. size (), NaN);
+      vector<Notype> notypes;
+      arrayThreads (true, getDissims, fNamePairs. size (), notypes, & fNamePairs, & cache, intersection_min, hashes_ratio_min, dissims. data ());
+      FFOR (size_t, i, fNamePairs. size ())
+        output << fNamePairs [i]. first << '\t' << fNamePairs [i]. second << '\t' << dissims [i] << endl;
     }
 	}
 };
@@ -0,0 +1,55 @@
+#!/bin/bash --noprofile
+THIS=$( dirname $0 )
+source $THIS/../bash_common.sh
+if [ $# -ne 1 ]; then
+  echo "Test hash dissimilarities"
+  echo "#1: go"
+  exit 1
+fi
+
+
+TMP=$( mktemp )
+comment $TMP
+
+
+section "Random hashes"
+mkdir $TMP.hash
+for I in $( seq 1 40 ); do
+  # Overlapping ranges of a common pool of hashes with different densities: some size ratios are < 0.5
+  awk -v SEED=$I 'BEGIN {srand (SEED); start = int (rand () * 20000); p = 0.1 + rand () * 0.3; for (i = start; i < start + 30000; i++) if (rand () < p) print i + 1}' > $TMP.hash/obj$I
+  echo obj$I >> $TMP.list
+done
+
+section "hash2dissim: tiles = pairs"
+$THIS/hash2dissim  -qc                        $TMP.list $TMP.hash  $TMP.1
+$THIS/hash2dissim  -qc  -threads 3            $TMP.list $TMP.hash  $TMP.3
+diff $TMP.1.dm $TMP.3.dm
+$THIS/hash2dissim  -qc  -threads 3  -packed  $TMP.list $TMP.hash  $TMP.packed
+
+section "hash2bin"
+mkdir $TMP.bin
+while read OBJ; do
+  $THIS/hash2bin  -qc  $TMP.hash/$OBJ  $TMP.bin/$OBJ
+  # Hashes::loadBin() and Hashes::saveBin() are inverse
+  $THIS/hash2bin  -qc  $TMP.bin/$OBJ   $TMP.bin2
+  cmp $TMP.bin/$OBJ $TMP.bin2
+done < $TMP.list
+$THIS/hash2dissim  -qc  $TMP.list $TMP.bin  $TMP.bin
+diff $TMP.1.dm $TMP.bin.dm
+
+section "hash_request2dissim: binary = text"
+awk '{obj [NR] = $1} END {for (i = 1; i <= NR; i++) for (j = i + 1; j <= NR; j++) print obj [i], obj [j]}' $TMP.list > $TMP.pairs
+awk -v DIR=$TMP.hash '{print DIR "/" $1, DIR "/" $2}' $TMP.pairs > $TMP.pairs-text
+awk -v DIR=$TMP.bin  '{print DIR "/" $1, DIR "/" $2}' $TMP.pairs > $TMP.pairs-bin
+# A small cache evicts hashes
+$THIS/hash_request2dissim  -qc               -cache_hashes 20000  $TMP.pairs-text  $TMP.req-text
+$THIS/hash_request2dissim  -qc  -threads 3  -cache_hashes 20000  $TMP.pairs-bin   $TMP.req-bin
+cut -f 3 $TMP.req-text > $TMP.req-text3
+cut -f 3 $TMP.req-bin  > $TMP.req-bin3
+diff $TMP.req-text3 $TMP.req-bin3
+
+
+rm -r $TMP*
+
+
+success
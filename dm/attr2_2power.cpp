@@ -79,10 +79,10 @@ struct ThisApplication : Application
     FOR (size_t, i, ds. objs. size ())
 	    FOR (size_t, j, ds. objs. size ())
 	    {
-	      const Real r = attr->matr. get (false, i, j);
+	      const Real r = attr->get (i, j);
 	      if (isNan (r))
 	        continue;
-	      attr_new->matr. put (false, i, j, pow (r, power));
+	      attr_new->put (i, j, pow (r, power));
 	    }
 	    
 	  ds. qc ();
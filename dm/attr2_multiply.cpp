@@ -88,6 +88,7 @@ struct ThisApplication final : Application
     
     dist->decimals += (uint) max<long> (0, - DM_sp::round (log10 (coefficient)));
     
+    dist->unpack ();
     Matrix& matr = dist->matr;
     FOR (size_t, row, ds. objs. size ())
     FOR (size_t, col, ds. objs. size ())
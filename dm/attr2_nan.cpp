@@ -84,7 +84,7 @@ struct ThisApplication : Application
       const size_t j = ds. getName2objNum (f. name2);
       if (j == no_index)
         throw runtime_error ("Object " + strQuote (f. name2) + " is not in " + inFName);
-      var_cast (attr->matr). putSymmetric (i, j, NaN);
+      var_cast (attr) -> putSymm (i, j, NaN);
     }
 	  ds. qc ();
     
@@ -89,7 +89,7 @@ struct ThisApplication : Application
       const size_t j = ds. getName2objNum (name2);
       if (j == no_index)
         throw runtime_error ("Object " + strQuote (name2) + " is not in " + inFName);
-      var_cast (attr->matr). putSymmetric (i, j, value);
+      var_cast (attr) -> putSymm (i, j, value);
     }
 	  ds. qc ();
     
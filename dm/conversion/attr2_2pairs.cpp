@@ -83,6 +83,7 @@ struct ThisApplication : Application
     if (! dist)
     	throw runtime_error ("Two-way attribute " + attr2Name + " is not found");
 
+    const_cast <RealAttr2*> (dist) -> unpack ();
     const Matrix& matr = const_cast <RealAttr2*> (dist) -> matr;
     
     FOR (size_t, col, ds. objs. size ())
@@ -81,6 +81,7 @@ struct ThisApplication final : Application
     }
     ASSERT (dist);
 
+    const_cast <RealAttr2*> (dist) -> unpack ();
     Matrix& matr = const_cast <RealAttr2*> (dist) -> matr;
     
     OFStream f (mapFName);
@@ -48,36 +48,50 @@ namespace
 {
 
 
-double parseLine (string line,
-                  string &obj1,
-                  string &obj2,
-                  size_t attr_num)
-// Return: attribute value
+struct PairLine
 {
-//cout << line << endl;  
-  const string line_orig (line);
-  try 
+  string obj1;
+  string obj2;
+  Real value {NaN};
+  
+  
+  PairLine (string_view line,
+            size_t attr_num);
+    // Input: line: <obj1> <obj2> <attr1> <attr2> ...
+  PairLine () = default;
+};
+
+
+
+PairLine::PairLine (string_view line,
+                    size_t attr_num)
+{
+  // Tokens are separated by ' ' and '\t'
+  const auto next = [&line] () 
+    { const size_t start = line. find_first_not_of (" \t");
+      if (start == string_view::npos)
+      { line = string_view ();
+        return line;
+      }
+      line. remove_prefix (start);
+      const size_t end = line. find_first_of (" \t");
+      const string_view token (line. substr (0, end));
+      line. remove_prefix (token. size ());
+      return token;
+    };
+  
+  obj1 = next ();
+  obj2 = next ();
+  FOR (size_t, i, attr_num + 1)
   {
-	  replace (line, '\t', ' ');
-	  replaceStr (line, "  ", " ");
-	  trim (line);
-	  obj1 = findSplit (line);
-	  obj2 = findSplit (line);
-	  FOR (size_t, i, attr_num + 1)
-	  {
-	    const string s (findSplit (line));
-	    if (i == attr_num)
-	    {
-	    //cout << s << endl;
-	      return str2real (s);
-	    }
-	  }
-	  throw runtime_error ("Attribute not found for " + obj1 + ", " + obj2);
-	}
-	catch (const exception &e)
-	{
-		throw runtime_error ("Line: " + line_orig + "\n" + e. what ());
-	}
+    const string_view s (next ());
+    if (i == attr_num && ! s. empty ())
+    {
+      value = str2real_fast (s);
+      return;
+    }
+  }
+  throw runtime_error ("Attribute not found for " + obj1 + ", " + obj2);
 }
 
 
@@ -86,7 +100,7 @@ double parseLine (string line,
 struct ThisApplication : Application
 {
   ThisApplication ()
-    : Application ("Convert object pairs to a " + dmSuff + "-file with a two-way attribute")
+    : Application ("Convert object pairs to a " + dmSuff + "-file with a two-way attribute", true, false, true)
     {
       version = VERSION;
   	  addPositional ("pairs", "File with lines: <obj1> <obj2> <attr1> <attr2> ...");
@@ -115,16 +129,18 @@ struct ThisApplication : Application
 		constexpr size_t displayPeriod = 1000000;
 		
 		
+    Vector<PairLine> pairLines;
+    parseLines (pairsFName, [attr_num] (string_view line, PairLine &pl) 
+                              { pl = PairLine (line, attr_num);
+                                return true;
+                              }
+               , pairLines, displayPeriod);
+
     Set<string> objNames;
+    for (const PairLine& pl : pairLines)
     {
-      LineInput f (pairsFName, displayPeriod);  
-      while (f. nextLine ())
-      {
-        string obj1, obj2;
-        parseLine (f. line, obj1, obj2, attr_num);
-        objNames << obj1;
-        objNames << obj2;
-      }
+      objNames << pl. obj1;
+      objNames << pl. obj2;
     }
 
     Dataset ds;
@@ -136,24 +152,23 @@ struct ThisApplication : Application
                         ? new PositiveAttr2 (attr_name, ds, decimals)
                         : new RealAttr2     (attr_name, ds, decimals);
     {
-      LineInput f (pairsFName, displayPeriod);  
-      while (f. nextLine ())
+      Progress prog (pairLines. size (), displayPeriod);  
+      for (const PairLine& pl : pairLines)
       {
-        string obj1, obj2;
-        const Real value = parseLine (f. line, obj1, obj2, attr_num);
-        const size_t row = ds. getName2objNum (obj1);
-        const size_t col = ds. getName2objNum (obj2);
+        prog ();
+        const size_t row = ds. getName2objNum (pl. obj1);
+        const size_t col = ds. getName2objNum (pl. obj2);
       #if 0
         if (! attr->isMissing2 (row, col))
         {
-          cout << obj1 << ' ' << obj2 << ": " << "duplicate value" << endl;
+          cout << pl. obj1 << ' ' << pl. obj2 << ": " << "duplicate value" << endl;
           ERROR;
         }
       #endif
         if (attr->isMissing2 (col, row))
-          attr->putSymm (row, col, value); 
+          attr->putSymm (row, col, pl. value); 
         else
-          attr->put (row, col, value); 
+          attr->put (row, col, pl. value); 
       }
     }
     
@@ -48,6 +48,7 @@ namespace DM_sp
 
 
 const string dmSuff ("." + string (dmExt));
+const string dmbSuff ("." + string (dmbExt));
 
 
 
@@ -1648,12 +1649,19 @@ void Attr2::save (ostream &os,
 
 // RealAttr2 
 
+size_t RealAttr2::packedObjs_min = no_index;
+
+
+
 RealAttr2::RealAttr2 (const string &name_arg,
 						          Dataset &ds_arg,
 						          streamsize decimals_arg)
 : Attr2 (name_arg, ds_arg, true)
 , RealScale (decimals_arg)
-, matr (ds. objs. size ())
+, matr (ds_arg. objs. size () >= packedObjs_min ? 0 : ds_arg. objs. size ())
+, packed (ds_arg. objs. size () >= packedObjs_min)
+, packedDim (packed ? ds_arg. objs. size () : 0)
+, packedMatr (packedDim * (packedDim + 1) / 2, NaN)
 { 
 	setMissingAll (); 
 }
@@ -1666,6 +1674,12 @@ RealAttr2::RealAttr2 (const string &name_arg,
 : Attr2 (name_arg, ds_arg, true)
 , RealScale (from. decimals)
 , matr (from. matr)
+, packed (from. packed)
+, packedDim (from. packedDim)
+, packedMatr (from. packedMatr)
+, packedMaxCorrection (from. packedMaxCorrection)
+, packedRow_bad (from. packedRow_bad)
+, packedCol_bad (from. packedCol_bad)
 {
   ASSERT (ds_arg. objs. size () == from. ds. objs. size ());
 }
@@ -1680,7 +1694,18 @@ void RealAttr2::qc () const
 	
   // matr[][]
   QC_ASSERT (matr. isSquare ());
-  QC_ASSERT (matr. rowsSize (false) == ds. objs. size ());
+  if (packed)
+  {
+    QC_ASSERT (! matr. rowsSize (false));
+    QC_ASSERT (packedDim == ds. objs. size ());
+    QC_ASSERT (packedMatr. size () == packedDim * (packedDim + 1) / 2);
+  }
+  else
+  {
+    QC_ASSERT (! packedDim);
+    QC_ASSERT (packedMatr. empty ());
+    QC_ASSERT (matr. rowsSize (false) == ds. objs. size ());
+  }
 #if 0
   FFOR (size_t, row, ds. objs. size ())
   FFOR (size_t, col, ds. objs. size ())
@@ -1712,8 +1737,43 @@ bool RealAttr2::isConstant () const
 
 
 
+void RealAttr2::saveText (ostream &os) const
+{ 
+  Attr2::saveText (os);
+  os << endl;
+  if (packed)
+    FFOR (size_t, row, packedDim)
+    {
+      FFOR (size_t, col, packedDim)
+        os << '\t' << get (row, col);
+      os << endl;
+    }
+  else
+    matr. saveText (os);
+}
+
+
+
 void RealAttr2::appendObj ()
 {
+  if (packed)
+  {
+    const Vector<float> packedMatr_old (std::move (packedMatr));
+    const size_t packedDim_old = packedDim;
+    packedDim++;
+    packedMatr. clear ();
+    packedMatr. resize (packedDim * (packedDim + 1) / 2, NaN);
+    size_t i = 0;
+    FFOR (size_t, row, packedDim_old)
+      FFOR_START (size_t, col, row, packedDim_old)
+      {
+        packedMatr [getPackedIndex (row, col)] = packedMatr_old [i];
+        i++;
+      }
+    ASSERT (i == packedMatr_old. size ());
+    return;
+  }
+  
 	const size_t objNum_max_old = matr. rowsSize (false);
 	FOR (char, b, 2)
     matr. insertRows (b, objNum_max_old, 1);
@@ -1731,11 +1791,94 @@ RealAttr2& RealAttr2::operator= (const RealAttr2& other)
   ASSERT (& other. ds == & ds);
   RealScale::operator= (other);
   matr = other. matr;
+  packed = other. packed;
+  packedDim = other. packedDim;
+  packedMatr = other. packedMatr;
+  packedMaxCorrection = other. packedMaxCorrection;
+  packedRow_bad = other. packedRow_bad;
+  packedCol_bad = other. packedCol_bad;
   return *this;
 }
 
 
 
+void RealAttr2::symmetrize (Real &maxCorrection,
+                            size_t &row_bad,
+                            size_t &col_bad)
+{
+  maxCorrection = 0.0;
+  row_bad = no_index;
+  col_bad = no_index;
+  if (! packed)
+    matr. symmetrize (maxCorrection, row_bad, col_bad);
+  // The values put() before unpack() are also reported
+  if (maximize (maxCorrection, packedMaxCorrection))
+  {
+    row_bad = packedRow_bad;
+    col_bad = packedCol_bad;
+  }
+  packedMaxCorrection = 0.0;
+  packedRow_bad = no_index;
+  packedCol_bad = no_index;
+}
+
+
+
+void RealAttr2::pack ()
+{
+  if (packed)
+    return;
+    
+  Real maxCorrection;
+  size_t row_bad, col_bad;
+  symmetrize (maxCorrection, row_bad, col_bad);
+  packedMaxCorrection = maxCorrection;
+  packedRow_bad = row_bad;
+  packedCol_bad = col_bad;
+  packedDim = matr. rowsSize (false);
+  packedMatr. clear ();
+  packedMatr. reserve (packedDim * (packedDim + 1) / 2);
+  FFOR (size_t, row, packedDim)
+    FFOR_START (size_t, col, row, packedDim)
+      packedMatr << (float) matr. get (false, row, col);
+  matr. resize (0);
+  packed = true;
+}
+
+
+
+void RealAttr2::unpack ()
+{
+  if (! packed)
+    return;
+    
+  matr. resize (packedDim);
+  FFOR (size_t, row, packedDim)
+    FFOR_START (size_t, col, row, packedDim)
+      matr. putSymmetric (row, col, get (row, col));
+  packed = false;
+  packedDim = 0;
+  packedMatr. clear ();
+  packedMatr. shrink_to_fit ();
+}
+
+
+
+bool RealAttr2::zeroDiagonal (size_t &row) const
+{
+  if (! packed)
+    return matr. zeroDiagonal (row);
+  FFOR (size_t, i, packedDim)
+    if (get (i, i))
+    {
+      row = i;
+      return false;
+    }
+  return true;
+}
+
+
+
 bool RealAttr2::existsLessThan (Real minValue,
                                 size_t &row,
                                 size_t &col) const
@@ -1845,6 +1988,236 @@ void loadObjPair (const string &objName1,
 
 
 
+namespace
+{
+  
+// Binary dataset file, see Dataset::saveBin()
+
+constexpr uint32_t datasetBin_version = 1;
+const string datasetBin_magic ("Dataset.bin");
+
+
+struct DatasetBinHeader
+{
+  char magic [16];
+  uint32_t version {datasetBin_version};
+  uint32_t reserved {0};
+  
+  DatasetBinHeader ()
+    { memset (magic, 0, sizeof (magic));
+      memcpy (magic, datasetBin_magic. c_str (), datasetBin_magic. size ());
+    }
+};
+
+
+struct DatasetBinBlock
+{
+  char type {'\0'};
+    // Dataset: 'C': comments, 'O': object names, 'M': Obj::mult's, 'T': Obj::comment's, 
+    //          'A': pairs of Attr::name and Attr::getTypeStr()
+    // Attr values: 'R': double, 'I': int32_t, 'E': ebool as uint8_t, 'B': bool as uint8_t, 'N': uint64_t category index, 
+    //              'D': double matrix by rows, 'F': float upper triangle by rows
+  uint8_t reserved [7] {0, 0, 0, 0, 0, 0, 0};
+  uint64_t num {0};
+    // # values or strings
+  uint64_t bytes {0};
+    // Multiple of 8 to align the next block
+};
+
+
+static_assert (sizeof (DatasetBinHeader) == 24);
+static_assert (sizeof (DatasetBinBlock)  == 24);
+
+
+
+void datasetBin_writeBlockHeader (ostream &os,
+                                  char type,
+                                  size_t num,
+                                  size_t bytes)
+{
+  DatasetBinBlock block;
+  block. type = type;
+  block. num = num;
+  block. bytes = (bytes + 7) / 8 * 8;
+  writeBin (os, block);
+}
+
+
+
+void datasetBin_pad (ostream &os,
+                     size_t bytes)
+{
+  while (bytes % 8)
+  {
+    os. put ('\0');
+    bytes++;
+  }
+}
+
+
+
+template <typename T>
+  void datasetBin_writeValues (ostream &os,
+                               char type,
+                               const Vector<T> &values)
+  {
+    const size_t bytes = values. size () * sizeof (T);
+    datasetBin_writeBlockHeader (os, type, values. size (), bytes);
+    os. write (reinterpret_cast <const char*> (values. data ()), (streamsize) bytes);
+    datasetBin_pad (os, bytes);
+  }
+
+
+
+void datasetBin_writeStrings (ostream &os,
+                              char type,
+                              const StringVector &strings)
+{
+  string pool;
+  for (const string& s : strings)
+  {
+    ASSERT (! contains (s, '\0'));
+    pool += s;
+    pool += '\0';
+  }
+  datasetBin_writeBlockHeader (os, type, strings. size (), pool. size ());
+  os. write (pool. c_str (), (streamsize) pool. size ());
+  datasetBin_pad (os, pool. size ());
+}
+
+
+StringVector datasetBin_readStrings (const char* data,
+                                     const DatasetBinBlock &block,
+                                     const string &fName)
+{
+  StringVector strings;  strings. reserve ((size_t) block. num);
+  const char* end = data + block. bytes;
+  FOR (uint64_t, i, block. num)
+  {
+    const char* nul = static_cast <const char*> (memchr (data, '\0', (size_t) (end - data)));
+    if (! nul)
+      throw runtime_error (FUNC + strQuote (fName) + ": string is not terminated");
+    strings << string (data, nul);
+    data = nul + 1;
+  }
+  return strings;
+}
+
+
+
+#ifndef _MSC_VER
+template <typename T>
+  const T* datasetBin_getValues (const MappedFile &mf,
+                                 size_t pos,
+                                 const DatasetBinBlock &block,
+                                 size_t num)
+  // Input: pos: start of the block data
+  {
+    if (   block. num != num
+        || block. num * sizeof (T) > block. bytes
+       )
+      throw runtime_error (FUNC + strQuote (mf. fName) + " is damaged");
+    return mf. getArray<T> (pos);
+  }
+#endif
+
+}
+
+
+
+Dataset::Dataset (const string &fName)
+{
+  const string fName_ (fName + dmSuff);
+  const string binFName (fName + dmbSuff);
+  if (   fileExists (binFName)
+      && (   ! fileExists (fName_)
+          || std::filesystem::last_write_time (binFName) >= std::filesystem::last_write_time (fName_)
+         )
+     )
+  {
+    loadBin (binFName);
+    return;
+  }
+
+  IFStream is (fName_);
+  char* buf = nullptr;
+  if (! is. rdbuf () -> pubsetbuf (buf, 1000000))   // PAR
+  	throw runtime_error ("Cannot allocate buffer to " + strQuote (fName_));
+  load (is);
+}
+
+
+
+Attr* Dataset::createAttr (const string &attrName,
+                          const string &type,
+                          istream &is)
+{
+  Attr* attr = nullptr;
+  streamsize decimals;
+  if (type == "REAL")
+  {
+    is >> decimals;
+    attr = new RealAttr1 (attrName, *this, decimals);
+  }
+  else if (type == "REAL2")
+  {
+    is >> decimals;
+    attr = new RealAttr2 (attrName, *this, decimals);
+  }
+  else if (type == "POSITIVE")
+  {
+    is >> decimals;
+    attr = new PositiveAttr1 (attrName, *this, decimals);
+  }
+  else if (type == "POSITIVE2")
+  {
+    is >> decimals;
+    attr = new PositiveAttr2 (attrName, *this, decimals);
+  }
+  else if (type == "PROBABILITY")
+  {
+    is >> decimals;
+    attr = new ProbAttr1 (attrName, *this, decimals);
+  }
+  else if (type == "INTEGER")
+    attr = new IntAttr1 (attrName, *this);
+  else if (type == "BOOLEAN")
+    attr = new ExtBoolAttr1 (attrName, *this);
+  else if (type == "COMPACTBOOLEAN")
+    attr = new CompactBoolAttr1 (attrName, *this);
+  else if (   type == "NOMINAL"
+         //|| type == "ORDINAL"
+          )
+  {
+    NominAttr1* nominAttr = /*type == "NOMINAL" 
+                              ?*/ new NominAttr1 (attrName, *this)
+                              /*: new OrdAttr1   (attrName, *this)*/;
+    attr = nominAttr;
+    string s;
+    string categoriesS;
+    bool more = true;
+    while (more)
+    {
+      getline (is, s);
+      trim (s);
+      more = trimSuffix (s, "\\");
+      categoriesS += s;
+    }
+    replace (categoriesS, '\t', ' ');
+    replaceStr (categoriesS, "  ", " ");
+    const List<string> categories (str2list (categoriesS));
+    for (const string& cat : categories)
+      nominAttr->category2index (cat);
+  //ASSERT (! nominAttr->categories. empty ());
+  }
+  if (! attr)
+    throw runtime_error (FUNC "Attribute " + strQuote (attrName) + " of unknown type " + strQuote (type));
+    
+  return attr;
+}
+
+
+
 void Dataset::load (istream &is)
 {
   if (! is. good ())
@@ -1925,67 +2298,7 @@ void Dataset::load (istream &is)
       is >> type;
       strUpper (type);
   
-  
-      // Attr
-      Attr* attr = nullptr;
-      streamsize decimals;
-      if (type == "REAL")
-      {
-        is >> decimals;
-        attr = new RealAttr1 (attrName, *this, decimals);
-      }
-      else if (type == "REAL2")
-      {
-        is >> decimals;
-        attr = new RealAttr2 (attrName, *this, decimals);
-      }
-      else if (type == "POSITIVE")
-      {
-        is >> decimals;
-        attr = new PositiveAttr1 (attrName, *this, decimals);
-      }
-      else if (type == "POSITIVE2")
-      {
-        is >> decimals;
-        attr = new PositiveAttr2 (attrName, *this, decimals);
-      }
-      else if (type == "PROBABILITY")
-      {
-        is >> decimals;
-        attr = new ProbAttr1 (attrName, *this, decimals);
-      }
-      else if (type == "INTEGER")
-        attr = new IntAttr1 (attrName, *this);
-      else if (type == "BOOLEAN")
-        attr = new ExtBoolAttr1 (attrName, *this);
-      else if (type == "COMPACTBOOLEAN")
-        attr = new CompactBoolAttr1 (attrName, *this);
-      else if (   type == "NOMINAL"
-             //|| type == "ORDINAL"
-              )
-      {
-        NominAttr1* nominAttr = /*type == "NOMINAL" 
-                                  ?*/ new NominAttr1 (attrName, *this)
-                                  /*: new OrdAttr1   (attrName, *this)*/;
-        attr = nominAttr;
-        string categoriesS;
-        bool more = true;
-        while (more)
-        {
-          getline (is, s);
-          trim (s);
-          more = trimSuffix (s, "\\");
-          categoriesS += s;
-        }
-        replace (categoriesS, '\t', ' ');
-        replaceStr (categoriesS, "  ", " ");
-        const List<string> categories (str2list (categoriesS));
-        for (const string& cat : categories)
-          nominAttr->category2index (cat);
-      //ASSERT (! nominAttr->categories. empty ());
-      }
-      if (! attr)
-        throw runtime_error (FUNC "Attribute " + strQuote (attrName) + " of unknown type " + strQuote (type));
+      createAttr (attrName, type, is);
     }
   }
   if (attrs. empty ())
@@ -2228,6 +2541,178 @@ void Dataset::load (istream &is)
 
 
 
+void Dataset::loadBin (const string &fName)
+{
+#ifndef _MSC_VER
+  const MappedFile mf (fName, true);
+  size_t pos = 0;
+
+  DatasetBinHeader header;
+  mf. readBin (pos, header);
+  if (strncmp (header. magic, datasetBin_magic. c_str (), sizeof (header. magic)))
+    throw runtime_error (FUNC + strQuote (fName) + " is not a binary dataset file");
+  if (header. version != datasetBin_version)
+    throw runtime_error (FUNC + strQuote (fName) + ": unsupported binary dataset file version " + to_string (header. version));
+
+  bool objsLoaded = false;
+  VectorPtr<Attr> attrVec;
+  size_t attrNum = 0;
+    // Index in attrVec of the next block of values
+  while (pos < mf. size)
+  {
+    DatasetBinBlock block;
+    mf. readBin (pos, block);
+    if (pos + block. bytes > mf. size)
+      throw runtime_error (FUNC + strQuote (fName) + " is truncated");
+    const char* data = mf. data + pos;
+    const size_t n = objs. size ();
+    switch (block. type)
+    {
+      case 'C':
+        for (const string& s : datasetBin_readStrings (data, block, fName))
+          comments << s;
+        break;
+      case 'O':
+        QC_ASSERT (! objsLoaded);
+        for (const string& s : datasetBin_readStrings (data, block, fName))
+          objs << new Obj (s);
+        objsLoaded = true;
+        break;
+      case 'M':
+        {
+          QC_ASSERT (objsLoaded);
+          const double* values = datasetBin_getValues<double> (mf, pos, block, n);
+          FFOR (size_t, i, n)
+            var_cast (objs [i]) -> mult = values [i];
+        }
+        break;
+      case 'T':
+        {
+          QC_ASSERT (objsLoaded);
+          const StringVector objComments (datasetBin_readStrings (data, block, fName));
+          QC_ASSERT (objComments. size () == n);
+          FFOR (size_t, i, n)
+            var_cast (objs [i]) -> comment = objComments [i];
+        }
+        break;
+      case 'A':
+        {
+          QC_ASSERT (objsLoaded);
+          QC_ASSERT (attrs. empty ());
+          const StringVector vec (datasetBin_readStrings (data, block, fName));
+          QC_ASSERT (vec. size () % 2 == 0);
+          Istringstream iss;
+          string type;
+          for (size_t i = 0; i < vec. size (); i += 2)
+          {
+            iss. reset (vec [i + 1]);
+            iss >> type;
+            strUpper (type);
+            attrVec << createAttr (vec [i], type, iss);
+          }
+        }
+        break;
+      default:
+        {
+          if (attrNum >= attrVec. size ())
+            throw runtime_error (FUNC + strQuote (fName) + ": unexpected block of values");
+          Attr* attr = var_cast (attrVec [attrNum]);
+          attrNum++;
+          const string typeError (FUNC + strQuote (fName) + ": attribute " + strQuote (attr->name) + " has a wrong block type");
+          switch (block. type)
+          {
+            case 'R':
+              {
+                auto* a = var_cast (attr->asRealAttr1 ());
+                if (! a)
+                  throw runtime_error (typeError);
+                const double* values = datasetBin_getValues<double> (mf, pos, block, n);
+                FFOR (size_t, i, n)
+                  (*a) [i] = values [i];
+              }
+              break;
+            case 'I':
+              {
+                auto* a = var_cast (attr->asIntAttr1 ());
+                if (! a)
+                  throw runtime_error (typeError);
+                const int32_t* values = datasetBin_getValues<int32_t> (mf, pos, block, n);
+                FFOR (size_t, i, n)
+                  (*a) [i] = values [i];
+              }
+              break;
+            case 'E':
+            case 'B':
+              {
+                auto* a = var_cast (attr->asBoolAttr1 ());
+                if (! a || (block. type == 'E') != (bool) a->asExtBoolAttr1 ())
+                  throw runtime_error (typeError);
+                const uint8_t* values = datasetBin_getValues<uint8_t> (mf, pos, block, n);
+                FFOR (size_t, i, n)
+                {
+                  QC_ASSERT (values [i] <= enull);
+                  a->setBool (i, (ebool) values [i]);
+                }
+              }
+              break;
+            case 'N':
+              {
+                auto* a = var_cast (attr->asNominAttr1 ());
+                if (! a)
+                  throw runtime_error (typeError);
+                const uint64_t* values = datasetBin_getValues<uint64_t> (mf, pos, block, n);
+                FFOR (size_t, i, n)
+                  (*a) [i] = (size_t) values [i];
+              }
+              break;
+            case 'D':
+              {
+                auto* a = var_cast (attr->asRealAttr2 ());
+                if (! a)
+                  throw runtime_error (typeError);
+                const double* values = datasetBin_getValues<double> (mf, pos, block, n * n);
+                FFOR (size_t, row, n)
+                  FFOR (size_t, col, n)
+                    a->put (row, col, values [row * n + col]);
+              }
+              break;
+            case 'F':
+              {
+                auto* a = var_cast (attr->asRealAttr2 ());
+                if (! a)
+                  throw runtime_error (typeError);
+                const float* values = datasetBin_getValues<float> (mf, pos, block, n * (n + 1) / 2);
+                FFOR (size_t, row, n)
+                  FFOR_START (size_t, col, row, n)
+                  {
+                    a->putSymm (row, col, (Real) *values);
+                    values++;
+                  }
+              }
+              break;
+            default:
+              throw runtime_error (FUNC + strQuote (fName) + ": unknown block type");
+          }
+        }
+    }
+    pos += block. bytes;
+  }
+  if (! objsLoaded)
+    throw runtime_error (FUNC + strQuote (fName) + ": no objects");
+  if (attrs. empty ())
+  	throw runtime_error (FUNC + strQuote (fName) + ": no attributes");
+  if (attrNum != attrVec. size ())
+    throw runtime_error (FUNC + strQuote (fName) + ": no values of attribute " + strQuote (attrVec [attrNum] -> name));
+#else
+  NOT_IMPLEMENTED;
+#endif
+
+  setName2objNum ();
+  qc ();
+}
+
+
+
 Dataset::Dataset (const Eigens &eigens)
 {
   FFOR (size_t, i, eigens. getDim ())
@@ -2294,6 +2779,132 @@ void Dataset::saveText (ostream &os) const
 
 
 
+void Dataset::saveBin (const string &fName) const
+{
+  ofstream f (fName, ios_base::binary | ios_base::out);
+  if (! f. good ())
+    throw runtime_error (FUNC "Cannot create file " + shellQuote (fName));
+
+  writeBin (f, DatasetBinHeader ());
+
+  {
+    StringVector vec;  vec. reserve (comments. size ());
+    insertAll (vec, comments);
+    datasetBin_writeStrings (f, 'C', vec);
+  }
+  {
+    StringVector names;  names. reserve (objs. size ());
+    for (const Obj* obj : objs)
+      names << obj->name;
+    datasetBin_writeStrings (f, 'O', names);
+  }
+  if (! getUnitMult ())
+  {
+    Vector<double> mults;  mults. reserve (objs. size ());
+    for (const Obj* obj : objs)
+      mults << obj->mult;
+    datasetBin_writeValues (f, 'M', mults);
+  }
+  if (objCommented ())
+  {
+    StringVector objComments;  objComments. reserve (objs. size ());
+    for (const Obj* obj : objs)
+      objComments << obj->comment;
+    datasetBin_writeStrings (f, 'T', objComments);
+  }
+  {
+    StringVector vec;  vec. reserve (2 * attrs. size ());
+    for (const Attr* attr : attrs)
+    {
+      vec << attr->name;
+      vec << attr->getTypeStr ();
+    }
+    datasetBin_writeStrings (f, 'A', vec);
+  }
+
+  const size_t n = objs. size ();
+  for (const Attr* attr : attrs)
+    if (const RealAttr1* realAttr = attr->asRealAttr1 ())
+    {
+      Vector<double> values;  values. reserve (n);
+      FFOR (size_t, i, n)
+        values << (*realAttr) [i];
+      datasetBin_writeValues (f, 'R', values);
+    }
+    else if (const IntAttr1* intAttr = attr->asIntAttr1 ())
+    {
+      Vector<int32_t> values;  values. reserve (n);
+      FFOR (size_t, i, n)
+        values << (*intAttr) [i];
+      datasetBin_writeValues (f, 'I', values);
+    }
+    else if (const BoolAttr1* boolAttr = attr->asBoolAttr1 ())
+    {
+      Vector<uint8_t> values;  values. reserve (n);
+      FFOR (size_t, i, n)
+        values << (uint8_t) boolAttr->getBool (i);
+      datasetBin_writeValues (f, boolAttr->asExtBoolAttr1 () ? 'E' : 'B', values);
+    }
+    else if (const NominAttr1* nominAttr = attr->asNominAttr1 ())
+    {
+      Vector<uint64_t> values;  values. reserve (n);
+      FFOR (size_t, i, n)
+        values << (*nominAttr) [i];
+      datasetBin_writeValues (f, 'N', values);
+    }
+    else if (const RealAttr2* realAttr2 = attr->asRealAttr2 ())
+    {
+      // By rows to avoid a copy of the matrix
+      if (realAttr2->isPacked ())
+      {
+        const size_t num = n * (n + 1) / 2;
+        datasetBin_writeBlockHeader (f, 'F', num, num * sizeof (float));
+        Vector<float> row;  row. reserve (n);
+        FFOR (size_t, i, n)
+        {
+          row. clear ();
+          FFOR_START (size_t, j, i, n)
+            row << (float) realAttr2->get (i, j);
+          f. write (reinterpret_cast <const char*> (row. data ()), (streamsize) (row. size () * sizeof (float)));
+        }
+        datasetBin_pad (f, num * sizeof (float));
+      }
+      else
+      {
+        datasetBin_writeBlockHeader (f, 'D', n * n, n * n * sizeof (double));
+        Vector<double> row;  row. reserve (n);
+        FFOR (size_t, i, n)
+        {
+          row. clear ();
+          FFOR (size_t, j, n)
+            row << realAttr2->get (i, j);
+          f. write (reinterpret_cast <const char*> (row. data ()), (streamsize) (row. size () * sizeof (double)));
+        }
+      }
+    }
+    else
+      throw runtime_error (FUNC "Attribute " + strQuote (attr->name) + " of type " + strQuote (attr->getTypeStr ()) + " cannot be saved in a binary file");
+
+  f. close ();
+  if (! f. good ())
+    throw runtime_error (FUNC "Cannot write file " + shellQuote (fName));
+}
+
+
+
+bool Dataset::isBinFile (const string &fName)
+{
+  ifstream f (fName, ios_base::binary | ios_base::in);
+  if (! f. good ())
+    return false;
+  DatasetBinHeader header;
+  readBin (f, header);
+  return    f. good ()
+         && ! strncmp (header. magic, datasetBin_magic. c_str (), sizeof (header. magic));
+}
+
+
+
 JsonArray* Dataset::comments2Json (JsonContainer* parent,
                                    const string& name) const
 {
@@ -2618,7 +3229,7 @@ PositiveAttr2* getDist2 (const Space1<NumAttr1> &space,
   auto* dist = new PositiveAttr2 (attrName, ds, 4);  // PAR
   FFOR (size_t, row, ds. objs. size ())
   {
-  	dist->matr. putDiag (row, 0.0);
+  	dist->put (row, row, 0.0);
     FOR (size_t, col, row)
     {
     	Real diff = 0.0;  
@@ -2631,7 +3242,7 @@ PositiveAttr2* getDist2 (const Space1<NumAttr1> &space,
     	     )
     	    diff += sqr ((*attr) [row] - (*attr) [col]); 
     	}
-      dist->matr. putSymmetric (row, col, diff);
+      dist->putSymm (row, col, diff);
     }
   }
   
@@ -2673,7 +3284,7 @@ PositiveAttr2* getHammingDist (const Space1<ProbAttr1> &space,
   auto* dist = new PositiveAttr2 (attrName, ds, 4);  // PAR
   FFOR (size_t, row, ds. objs. size ())
   {
-  	dist->matr. putDiag (row, 0.0);
+  	dist->put (row, row, 0.0);
     FOR (size_t, col, row)
     {
     	Real diff = 0.0;  
@@ -2690,7 +3301,7 @@ PositiveAttr2* getHammingDist (const Space1<ProbAttr1> &space,
     	  Real diff1 = p1 + p2 - 2 * p1 * p2;
     	  diff += diff1;
     	}
-      dist->matr. putSymmetric (row, col, diff);
+      dist->putSymm (row, col, diff);
     }
   }
   
@@ -2726,11 +3337,12 @@ RealAttr2* getSimilarity (const Space1<RealAttr1> &space,
     	    continue;  
     	  s += rowValue * colValue; 
     	}
-      sim->matr. putSymmetric (row, col, s);
+      sim->putSymm (row, col, s);
     }
   }
   
-  sim->matr. psd = true;
+  if (! sim->isPacked ())
+    sim->matr. psd = true;
   
   return sim;
 }
@@ -6310,7 +6922,8 @@ Mds::Mds (const Sample &sample_arg,
           const RealAttr2 &attr2,
 		      size_t outDim_max,
 	        Prob totalExplainedFrac_max,
-	        Prob explainedFrac_min)
+	        Prob explainedFrac_min,
+	        bool subspace)
 : Analysis (sample_arg)
 , eigens ( attr2. matr
  	       , outDim_max
@@ -6318,10 +6931,12 @@ Mds::Mds (const Sample &sample_arg,
 	       , explainedFrac_min
 	       , 1e-5  // PAR
 	       , 10000  // PAR
+	       , subspace
 	       )
 {
   ASSERT (sample. ds == & attr2. ds);
   ASSERT (sample. ds->getUnitMult ());
+  ASSERT (! attr2. isPacked ());
 //ASSERT (! attr2. matr. psd);  // PCA via MDS
 }
 
@@ -50,6 +50,8 @@ namespace DM_sp
 
 constexpr const char* dmExt {"dm"};
 extern const string dmSuff;  // = "." + dmExt
+constexpr const char* dmbExt {"dmb"};
+extern const string dmbSuff;  // = "." + dmbExt
 constexpr const char* missingStr {"?"};
 
 
@@ -963,21 +965,33 @@ public:
 struct RealAttr2 : Attr2, RealScale
 {
   Matrix matr;
+    // !isPacked()
+private:
+  bool packed {false};
+  size_t packedDim {0};
+  Vector<float> packedMatr;
+    // Upper triangle with the diagonal by rows
+    // size() = packedDim * (packedDim + 1) / 2
+  Real packedMaxCorrection {0.0};
+  size_t packedRow_bad {no_index};
+  size_t packedCol_bad {no_index};
+    // Conflicting put()'s of (row,col) and (col,row) since the last symmetrize()
+public:
+  static size_t packedObjs_min;
+    // A new attribute is packed if the # objects is >= packedObjs_min
+    // Default: no_index, i.e. packing is requested by the application
 
   
   RealAttr2 (const string &name_arg,
              Dataset &ds_arg,
              streamsize decimals_arg = decimals_def);
+    // Invokes: pack() if ds_arg.objs.size() >= packedObjs_min
   RealAttr2 (const string &name_arg,
              Dataset &ds_arg,
              const RealAttr2 &from);
   RealAttr2& operator= (const RealAttr2& other);
   void qc () const override;
-  void saveText (ostream &os) const final
-    { Attr2::saveText (os);
-      os << endl;
-      matr. saveText (os);
-    }
+  void saveText (ostream &os) const final;
 
 
   const RealAttr2* asRealAttr2 () const final
@@ -1017,30 +1031,86 @@ struct RealAttr2 : Attr2, RealScale
   void symmetrize () override
     { Real maxCorrection;
       size_t row_bad, col_bad;
-      matr. symmetrize (maxCorrection, row_bad, col_bad);
+      symmetrize (maxCorrection, row_bad, col_bad);
     }    
+  void symmetrize (Real &maxCorrection,
+                   size_t &row_bad,
+                   size_t &col_bad);
+    // Output: see Matrix::symmetrize(); includes the conflicting put()'s in the packed mode
     
+  // Packed storage: symmetric, float
+  // Memory: 1/4 of matr
+  bool isPacked () const
+    { return packed; }
+  void pack ();
+    // Invokes: symmetrize()
+  void unpack ();
+    // To use matr
+private:
+  size_t getPackedIndex (size_t row,
+                         size_t col) const
+    { if (row > col)
+        std::swap (row, col);
+      return row * (2 * packedDim - row + 1) / 2 + col - row;
+    }
+public:
+
   Value get (size_t row,
              size_t col) const
-    { return matr. get (false, row, col); }
+    { return packed 
+               ? (Value) packedMatr [getPackedIndex (row, col)] 
+               : matr. get (false, row, col); 
+    }
   void put (size_t row,
             size_t col, 
             Value value) 
-    { matr. put (false, row, col, value); }
+    { if (packed)
+      { float &f = packedMatr [getPackedIndex (row, col)];
+        if (   row != col
+            && ! isNan (f)
+            && ! isNan (value)
+            && f != (float) value
+           )
+        { // As in Matrix::symmetrize()
+          const Real c = ((Real) f + value) / 2.0;
+          if (maximize (packedMaxCorrection, fabs (value - c)))
+          { packedRow_bad = row;
+            packedCol_bad = col;
+          }
+          f = (float) c;
+        }
+        else
+          f = (float) value;
+      }
+      else
+        matr. put (false, row, col, value); 
+    }
+    // isPacked() => put(col,row,value), a different value of (col,row) is averaged with value
   void putSymm (size_t row,
                 size_t col, 
                 Value value) 
-    { put (row, col, value); 
-      if (row != col)
-        put (col, row, value); 
+    { if (packed)
+        packedMatr [getPackedIndex (row, col)] = (float) value;
+      else
+      { put (row, col, value); 
+        if (row != col)
+          put (col, row, value); 
+      }
     }
+  bool zeroDiagonal (size_t &row) const;
+    // Output: row - a non-0 diagonal element; valid if result is false
+    // Return: true if all elements of the diagonal are 0
   
   bool existsLessThan (Value minValue,
                        size_t &row,
                        size_t &col) const;
     // Output: row,col: valid if return is true
   void setAll (Value value)
-    { matr. putAll (value); }
+    { if (packed)
+        std::fill (packedMatr. begin (), packedMatr. end (), (float) value);
+      else
+        matr. putAll (value); 
+    }
   void setDiag (Real value);
   size_t getInfCount () const;
   size_t inf2missing ();
@@ -1113,17 +1183,21 @@ public:
 
 
   Dataset () = default;
-  explicit Dataset (const string &fName)
-    { const string fName_ (fName + dmSuff);
-      IFStream is (fName_);
-  	  char* buf = nullptr;
-		  if (! is. rdbuf () -> pubsetbuf (buf, 1000000))   // PAR
-		  	throw runtime_error ("Cannot allocate buffer to " + strQuote (fName_));
-      load (is);
-    }
+  explicit Dataset (const string &fName);
+    // Loads <fName><dmbSuff> if it exists and is not older than <fName><dmSuff>, otherwise <fName><dmSuff>
   explicit Dataset (istream &is)
     { load (is); }
+  class BinFormat {};  // dummy
+  Dataset (BinFormat,
+           const string &binFName)
+    { loadBin (binFName); }
 private:
+  Attr* createAttr (const string &attrName,
+                    const string &type,
+                    istream &is);
+    // Return: new, in attrs
+    // Input: type: upper-case first word of Attr::getTypeStr()
+    //        is: the rest of Attr::getTypeStr()
   void load (istream &is);
     // Loading from a text file in the <dmSuff>-format:
     //
@@ -1153,6 +1227,11 @@ private:
     // Missings are coded by <missing>
     // Empty lines are allowed
     // Invokes: setName2objNum(), qc()
+  void loadBin (const string &fName);
+    // Input: fName: saved by saveBin()
+    // RealAttr2::isPacked() is decided as in load()
+    // Invokes: setName2objNum(), qc()
+    // Time: O(size of fName)
 public:
   explicit Dataset (const Eigens &eigens);
     // RealAttr1: unit, "Order" (log), "EigenValueFrac" (log)
@@ -1162,6 +1241,15 @@ public:
   void saveText (ostream &os) const override;
   bool empty () const override
     { return objs. empty () && attrs. empty (); }
+  void saveBin (const string &fName) const;
+    // Binary <dmbSuff>-format, can be memory-mapped:
+    //   <header> <block>*, each block is 8-byte aligned:
+    //     comments, objects, [multiplicities], [object comments], attributes (names and getTypeStr()'s),
+    //     then a block of values for each attribute:
+    //       Attr1: a column by objects
+    //       Attr2: a matrix by rows of double's, or the upper triangle by rows of float's if RealAttr2::isPacked()
+    // Missing values are coded as in the attribute storage
+  static bool isBinFile (const string &fName);
 
 
   JsonArray* comments2Json (JsonContainer* parent,
@@ -3747,7 +3835,8 @@ struct PrinComp final : MultiVariate<NumAttr1>
             size_t maxCount,
             Prob totalExplainedFrac_max,
             Prob explainedFrac_min,
-            Real error)
+            Real error,
+            bool subspace = false)
     : P (sample_arg, space_arg)
     , mn (mn_arg)
     , eigens ( mn. sigmaExact
@@ -3756,6 +3845,7 @@ struct PrinComp final : MultiVariate<NumAttr1>
              , explainedFrac_min
              , error
              , 5000  // PAR
+             , subspace
              )
     { mn. analysis = nullptr; }
   PrinComp* copy () const override
@@ -3970,7 +4060,9 @@ struct Mds final : Analysis
        const RealAttr2 &attr2,
        size_t outDim_max,
        Prob totalExplainedFrac_max,
-       Prob explainedFrac_min);
+       Prob explainedFrac_min,
+       bool subspace = false);
+    // Input: subspace: see Eigens::Eigens()
     // Requires: attr2.matr: defined(), symmetric, centered
     //           space.ds.getUnitMult() ??
     // Time: O(n^2 outDim_max)
@@ -240,6 +240,120 @@ struct ThisApplication : Application
 		              ;
 		
 		
+    section ("Packed RealAttr2", false);
+    {
+      const string fName ("data/Peptostreptococcaceae");
+      Dataset ds (fName);
+      const PositiveAttr2* attr = ds. name2attr ("Conservation") -> asPositiveAttr2 ();
+      ASSERT (attr);
+      ASSERT (! attr->isPacked ());
+      Real maxCorrection;
+      size_t row_bad, col_bad;
+      var_cast (attr) -> symmetrize (maxCorrection, row_bad, col_bad);
+      
+      const Keep<size_t> kp (RealAttr2::packedObjs_min);
+      RealAttr2::packedObjs_min = 0;
+      Dataset dsPacked (fName);
+      dsPacked. qc ();
+      const PositiveAttr2* attrPacked = dsPacked. name2attr ("Conservation") -> asPositiveAttr2 ();
+      ASSERT (attrPacked);
+      ASSERT (attrPacked->isPacked ());
+      FFOR (size_t, row, ds. objs. size ())
+        FFOR (size_t, col, ds. objs. size ())
+        {
+          const Real x = attr->get (row, col);
+          const Real y = attrPacked->get (row, col);
+          ASSERT (isNan (x) == isNan (y));
+          if (! isNan (x))
+            ASSERT_EQ (x, y, 1e-6 * max (1.0, fabs (x)));
+        }
+      {
+        Real maxCorrectionPacked;
+        size_t row_badPacked, col_badPacked;
+        var_cast (attrPacked) -> symmetrize (maxCorrectionPacked, row_badPacked, col_badPacked);
+        ASSERT_EQ (maxCorrection, maxCorrectionPacked, 1e-6);
+      }
+        
+      PositiveAttr2* attrCopy = attrPacked->copyAttr ("Copy");
+      attrCopy->putSymm (0, 1, 0.5);
+      ASSERT (attrCopy->get (1, 0) == 0.5);
+      attrCopy->put (1, 0, 0.7);
+      ASSERT_EQ (attrCopy->get (0, 1), 0.6, 1e-6);
+      {
+        size_t row_badCopy, col_badCopy;
+        attrCopy->symmetrize (maxCorrection, row_badCopy, col_badCopy);
+        ASSERT_EQ (maxCorrection, 0.1, 1e-6);
+        ASSERT (row_badCopy == 1);
+        ASSERT (col_badCopy == 0);
+      }
+      attrCopy->putSymm (0, 1, 0.5);
+      attrCopy->unpack ();
+      ASSERT (! attrCopy->isPacked ());
+      ASSERT (attrCopy->get (1, 0) == 0.5);
+      attrCopy->pack ();
+      dsPacked. appendObj ("new");
+      dsPacked. setName2objNum ();
+      dsPacked. qc ();
+      ASSERT (attrCopy->get (0, 1) == 0.5);
+      ASSERT (attrCopy->isMissing2 (0, dsPacked. objs. size () - 1));
+    }
+
+
+    section ("Binary dataset", false);
+    {
+      const string dir (makeTempDir ());
+      const string binFName (dir + "/ds" + dmbSuff);
+      const Dataset ds ("data/Peptostreptococcaceae");
+      ds. saveBin (binFName);
+      ASSERT (Dataset::isBinFile (binFName));
+      const PositiveAttr2* attr = ds. name2attr ("Conservation") -> asPositiveAttr2 ();
+      ASSERT (attr);
+      {
+        const Dataset dsBin (Dataset::BinFormat (), binFName);
+        ASSERT (dsBin. objs. size () == ds. objs. size ());
+        ASSERT (dsBin. attrs. size () == ds. attrs. size ());
+        const PositiveAttr2* attrBin = dsBin. name2attr ("Conservation") -> asPositiveAttr2 ();
+        ASSERT (attrBin);
+        FFOR (size_t, row, ds. objs. size ())
+        {
+          ASSERT (dsBin. objs [row] -> name == ds. objs [row] -> name);
+          FFOR (size_t, col, ds. objs. size ())
+          {
+            const Real x = attr->get (row, col);
+            const Real y = attrBin->get (row, col);
+            ASSERT (isNan (x) == isNan (y));
+            if (! isNan (x))
+              ASSERT (x == y);
+          }
+        }
+      }
+      {
+        const Keep<size_t> kp (RealAttr2::packedObjs_min);
+        RealAttr2::packedObjs_min = 0;
+        const Dataset dsPacked (Dataset::BinFormat (), binFName);
+        const PositiveAttr2* attrPacked = dsPacked. name2attr ("Conservation") -> asPositiveAttr2 ();
+        ASSERT (attrPacked);
+        ASSERT (attrPacked->isPacked ());
+        dsPacked. saveBin (binFName);
+        RealAttr2::packedObjs_min = kp. get ();
+        const Dataset dsUnpacked (Dataset::BinFormat (), binFName);
+        const PositiveAttr2* attrUnpacked = dsUnpacked. name2attr ("Conservation") -> asPositiveAttr2 ();
+        ASSERT (attrUnpacked);
+        ASSERT (! attrUnpacked->isPacked ());
+        FFOR (size_t, row, ds. objs. size ())
+          FFOR (size_t, col, ds. objs. size ())
+          {
+            const Real y = attrPacked->get (row, col);
+            const Real z = attrUnpacked->get (row, col);
+            ASSERT (isNan (y) == isNan (z));
+            if (! isNan (y))
+              ASSERT (y == z);
+          }
+      }
+      removeDirectory (dir);
+    }
+		
+		
     section ("Binomial", false);
     {
 	    Binomial bin;
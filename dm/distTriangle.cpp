@@ -146,6 +146,7 @@ Save clusters in " + dmSuff + "-files\
   		// Input
   	  addPositional ("file", dmSuff + "-file without the extension");
   	  addPositional ("attrName", "Attribute name of a distance in the <file>");
+  	  addFlag ("packed", "Store the two-way attributes as upper triangles of float's: 1/4 of memory; a value and its transposed value are averaged");
   	  addFlag("max_cliques", "Clusters must be maximal cliques");
   	  addKey ("hybridness_min", "Min. hybridness to report hybrids, >1", "NAN");
   	  addKey ("hybrid", "Output file with hybrids information. Line format: " + string (PositiveAttr2::hybrid_format));
@@ -163,6 +164,7 @@ Save clusters in " + dmSuff + "-files\
 		const bool   max_cliques    = getFlag ("max_cliques");
 		const string fName          = getArg ("file");
 		const string attrName       = getArg ("attrName");
+		const bool   packed         = getFlag ("packed");
 	  const Real   hybridness_min = str2real (getArg ("hybridness_min"));
 	  const string hybridFName    = getArg ("hybrid");
 		const Real   distance_max   = str2real (getArg ("distance_max"));
@@ -171,6 +173,8 @@ Save clusters in " + dmSuff + "-files\
 	    throw runtime_error ("-hybridness_min must be > 1.0");
 		
 		
+    if (packed)
+      RealAttr2::packedObjs_min = 0;
     Dataset ds (fName);
     
     // dist
@@ -187,7 +191,7 @@ Save clusters in " + dmSuff + "-files\
 	  {
       Real maxCorrection;
       size_t row_bad, col_bad;   
-      var_cast (dist) -> matr. symmetrize (maxCorrection, row_bad, col_bad);
+      var_cast (dist) -> symmetrize (maxCorrection, row_bad, col_bad);
       if (maxCorrection > 2 * pow (10, - (Real) dist->decimals))
         cout << "maxCorrection = " << maxCorrection << " at " << ds. objs [row_bad] -> name << ", " << ds. objs [col_bad] -> name << endl;
     }
@@ -207,12 +211,12 @@ Save clusters in " + dmSuff + "-files\
   #endif
 	  {
   	  size_t row;
-      if (! dist->matr. zeroDiagonal (row))
+      if (! dist->zeroDiagonal (row))
       {
       #if 0
-      	var_cast (dist->matr). put (false, row, row, 0);
+      	var_cast (dist) -> put (row, row, 0);
       #else
-       	cout << dist->name << " [" << row + 1 << "] [" << row + 1 << "] = " << dist->matr. get (false, row, row) << " != 0" << endl;
+       	cout << dist->name << " [" << row + 1 << "] [" << row + 1 << "] = " << dist->get (row, row) << " != 0" << endl;
        	exit (1);
       #endif
       }
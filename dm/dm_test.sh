@@ -21,10 +21,24 @@ $THIS/numeric_test -qc go
 
 section "matrix"
 $THIS/matrix_test -qc go
+$THIS/matrix_test -qc -threads 3 go
 
 section "dataset"
 $THIS/dataset_test -qc  -seed $SEED  go
 
+section "Binary dataset"
+$THIS/printDataset  -qc  $THIS/data/GENOME > $TMP.printDataset
+$THIS/dm2dmb  -qc  $THIS/data/GENOME  -out $TMP.dmb
+$THIS/dmb2dm  -qc  $TMP > $TMP.dmb2dm
+diff $TMP.printDataset $TMP.dmb2dm
+# Dataset uses <TMP>.dmb
+cp $THIS/data/blaLUT.dm $TMP.dm
+$THIS/dm2dmb  -qc  $TMP
+rm $TMP.dm
+$THIS/mds  -qc  -attrType 0  -maxAttr 2  -maxTotalExpl 1  -minExpl 0  -attr Similarity  $TMP > blaLUT.mds
+diff blaLUT.mds $THIS/data/blaLUT.mds
+rm blaLUT.mds
+
 
 super_section "PCA"
 section "pca"
@@ -70,6 +84,11 @@ $THIS/mds  -qc  -attrType 2  -maxClusters 4  -attr Conservation  $THIS/data/Bact
 diff Bacteria.mds $THIS/data/Bacteria.mds
 rm Bacteria.mds
 
+section "Bacteria -subspace"
+$THIS/mds  -qc  -subspace  -attrType 2  -maxClusters 4  -attr Conservation  $THIS/data/Bacteria  > Bacteria.mds
+diff <( grep '^Total explained fraction' Bacteria.mds | cut -c 1-34 ) <( grep '^Total explained fraction' $THIS/data/Bacteria.mds | cut -c 1-34 )
+rm Bacteria.mds
+
 section "bla-A"
 $THIS/mds  -qc  -attrType 0  -maxClusters 4  -class Class  -attr Similarity  $THIS/data/bla-A  > bla-A.mds
 diff bla-A.mds $THIS/data/bla-A.mds
@@ -1814,6 +1814,87 @@ void Matrix::putProdRow (bool  t,
 
 
 
+namespace
+{
+
+constexpr size_t gemm_lanes = 4;  // # columns of a panel
+constexpr size_t gemm_rowBlock = 64;  // PAR
+constexpr size_t gemm_depthBlock = 256;  // PAR
+constexpr size_t gemm_threadWork = 1000000;  // PAR
+
+
+
+template <size_t Rows>
+  inline void multiply_kernel (const Real* a,
+                               size_t depth,
+                               const Real* panel,
+                               size_t kStart,
+                               size_t kEnd,
+                               Real* c,
+                               size_t cols)
+  // Update: c[0..Rows-1][0..gemm_lanes-1]
+  // Input: a: Rows rows of length depth
+  //        panel: depth x gemm_lanes
+  {
+    Real s [Rows] [gemm_lanes];
+    FOR (size_t, r, Rows)
+      FOR (size_t, l, gemm_lanes)
+        s [r] [l] = c [r * cols + l];
+    FOR_START (size_t, k, kStart, kEnd)
+    {
+      const Real* b = panel + k * gemm_lanes;
+      FOR (size_t, r, Rows)
+      {
+        const Real x = a [r * depth + k];
+        FOR (size_t, l, gemm_lanes)
+          s [r] [l] += x * b [l];
+      }
+    }
+    FOR (size_t, r, Rows)
+      FOR (size_t, l, gemm_lanes)
+        c [r * cols + l] = s [r] [l];
+  }
+
+
+
+void multiply_array (size_t from,
+                     size_t to,
+                     Notype /*&res*/,
+                     const Real* a,
+                     size_t depth,
+                     const Real* panels,
+                     size_t panels_num,
+                     Real* c)
+// Update: c[from..to-1][]
+// Input: a: rows x depth, row-major
+//        panels: panels_num x depth x gemm_lanes
+//        c: rows x (panels_num * gemm_lanes), row-major
+// Summation over depth is sequential for each element of c, as in multiplyVec()
+{
+  const size_t cols = panels_num * gemm_lanes;
+  for (size_t rowStart = from; rowStart < to; rowStart += gemm_rowBlock)
+  {
+    const size_t rowEnd = min (to, rowStart + gemm_rowBlock);
+    for (size_t kStart = 0; kStart < depth; kStart += gemm_depthBlock)
+    {
+      const size_t kEnd = min (depth, kStart + gemm_depthBlock);
+      FOR (size_t, p, panels_num)
+      {
+        const Real* panel = panels + p * depth * gemm_lanes;
+        size_t row = rowStart;
+        for (; row + 2 <= rowEnd; row += 2)
+          multiply_kernel<2> (a + row * depth, depth, panel, kStart, kEnd, c + row * cols + p * gemm_lanes, cols);
+        if (row < rowEnd)
+          multiply_kernel<1> (a + row * depth, depth, panel, kStart, kEnd, c + row * cols + p * gemm_lanes, cols);
+      }
+    }
+  }
+}
+  
+}
+
+
+
 void Matrix::multiply (bool         t,
                        const Matrix &m1, 
                        bool         t1,
@@ -1825,6 +1906,74 @@ void Matrix::multiply (bool         t,
   ASSERT (    rowsSize (t)    == m1. rowsSize (t1));
   ASSERT (    rowsSize (! t)  == m2. rowsSize (! t2));
   ASSERT (m1. rowsSize (! t1) == m2. rowsSize (t2));
+  
+  const size_t rows  = m1. rowsSize (t1);
+  const size_t depth = m1. rowsSize (! t1);
+  const size_t cols  = m2. rowsSize (! t2);
+  const size_t panels_num = (cols + gemm_lanes - 1) / gemm_lanes;
+  
+  // Missing values are replaced by 0, which makes the products equal to multiplyVec()
+  bool infinite = false;
+  vector<Real> a (rows * depth);
+  FFOR (size_t, row, rows)
+    FFOR (size_t, k, depth)
+    {
+      Real r = m1. get (t1, row, k);
+      if (isNan (r))
+        r = 0.0;
+      else if (isinf (r))
+        infinite = true;
+      a [row * depth + k] = r;
+    }
+  vector<Real> panels (panels_num * depth * gemm_lanes, 0.0);
+  FFOR (size_t, col, cols)
+  {
+    Real* panel = & panels [(col / gemm_lanes) * depth * gemm_lanes + col % gemm_lanes];
+    FFOR (size_t, k, depth)
+    {
+      Real r = m2. get (t2, k, col);
+      if (isNan (r))
+        r = 0.0;
+      else if (isinf (r))
+        infinite = true;
+      panel [k * gemm_lanes] = r;
+    }
+  }
+  if (infinite)
+  {
+    // 0 * inf = NaN
+    multiplySimple (t, m1, t1, m2, t2);
+    return;
+  }
+
+  vector<Real> c (rows * panels_num * gemm_lanes, 0.0);
+  if (rows * cols * depth >= gemm_threadWork)
+  {
+    vector<Notype> notypes;
+    arrayThreads (true, multiply_array, rows, notypes, a. data (), depth, panels. data (), panels_num, c. data ());
+  }
+  else
+    multiply_array (0, rows, Notype (), a. data (), depth, panels. data (), panels_num, c. data ());
+
+  FFOR (size_t, row, rows) 
+	  FFOR (size_t, col, cols)
+	    put (t, row, col, c [row * panels_num * gemm_lanes + col]);
+  psd = & m1 == & m2 && t1 != t2;
+}
+
+
+
+void Matrix::multiplySimple (bool         t,
+                             const Matrix &m1, 
+                             bool         t1,
+                             const Matrix &m2,
+                             bool         t2)
+{
+  ASSERT (this != & m1);
+  ASSERT (this != & m2);
+  ASSERT (    rowsSize (t)    == m1. rowsSize (t1));
+  ASSERT (    rowsSize (! t)  == m2. rowsSize (! t2));
+  ASSERT (m1. rowsSize (! t1) == m2. rowsSize (t2));
 
   FFOR (size_t, row, rowsSize (t)) 
 	  FFOR (size_t, col, rowsSize (! t))
@@ -2697,7 +2846,8 @@ Eigens::Eigens (const Matrix &matr,
                 Prob totalExplainedFrac_max,
                 Prob explainedFrac_min,
                 Real relError,
-                size_t iter_max)
+                size_t iter_max,
+                bool subspace)
 : psd (matr. psd)
 , error (relError / sqrt ((Real) matr. rowsSize (false)))
 , totalExplained_max (matr. psd ? matr. getTrace () : matr. sumSqr ())
@@ -2733,6 +2883,12 @@ Eigens::Eigens (const Matrix &matr,
 
   VectorOwn<Eigen> vecs;  
     // Eigen::vector's are orthogonal
+  if (subspace)
+  {
+    subspaceIteration (matr, dim_max, totalExplainedFrac_max, explainedFrac_min, iter_max, vecs);
+    vecs2basis (matr, vecs);
+    return;
+  }
   Rand rand;
   Matrix work (matr);
   Real totalExplained = 0.0;
@@ -2867,6 +3023,15 @@ Eigens::Eigens (const Matrix &matr,
   eigen. release ();
   
 
+  vecs2basis (matr, vecs);
+}
+
+
+
+void Eigens::vecs2basis (const Matrix &matr,
+                         VectorOwn<Eigen> &vecs)
+{
+  const size_t len = matr. rowsSize (false);
   vecs. sortBubblePtr ();     
 
   basis. resize (false, len, vecs. size ());
@@ -2892,6 +3057,230 @@ Eigens::Eigens (const Matrix &matr,
 
 
 
+namespace
+{
+
+void orthonormalizeRows (Matrix &q,
+                         Rand &rand)
+// Modified Gram-Schmidt, twice
+// Update: q: rows are orthonormal
+// A linearly dependent row is replaced by a random vector
+{
+  FFOR (size_t, row, q. rowsSize (false))
+    for (;;)
+    {
+      const Real sqrNorma_init = q. sumSqrRow (false, row);
+      FOR (size_t, pass, 2)
+        FOR (size_t, prev, row)
+          EXEC_ASSERT (q. subtractProjectionRow (false, row, q, false, prev));
+      Real sqrNorma = NaN;
+      if (   q. normalizeRow (false, row, sqrNorma)
+          && sqrNorma > 1e-20 * sqrNorma_init  // PAR
+         )
+        break;
+      q. putRandomRow (false, row, rand);
+    }
+}
+
+
+
+void jacobiEigen (Matrix &a,
+                  Matrix &v)
+// Cyclic Jacobi rotations
+// Update: a: symmetric => diagonal of eigenvalues
+// Output: v: columns are eigenvectors
+// Time: O(n^3 sweeps)
+{
+  const size_t n = a. rowsSize (false);
+  ASSERT (v. rowsSize (false) == n);
+
+  v. putAll (0.0);
+  FFOR (size_t, i, n)
+    v. put (false, i, i, 1.0);
+
+  const Real off_min = sqr (numeric_limits<Real>::epsilon ()) * a. sumSqr ();
+  FOR (size_t, sweep, 100)  // PAR
+  {
+    Real off = 0.0;
+    FFOR (size_t, i, n)
+      FFOR_START (size_t, j, i + 1, n)
+        off += sqr (a. get (false, i, j));
+    if (off <= off_min)
+      break;
+    FFOR (size_t, i, n)
+      FFOR_START (size_t, j, i + 1, n)
+      {
+        const Real aij = a. get (false, i, j);
+        if (! aij)
+          continue;
+        const Real theta = (a. get (false, j, j) - a. get (false, i, i)) / (2.0 * aij);
+        const Real t = (theta >= 0.0 ? 1.0 : -1.0) / (fabs (theta) + sqrt (sqr (theta) + 1.0));
+        const Real c = 1.0 / sqrt (sqr (t) + 1.0);
+        const Real s = t * c;
+        FFOR (size_t, k, n)
+        {
+          const Real aki = a. get (false, k, i);
+          const Real akj = a. get (false, k, j);
+          a. put (false, k, i, c * aki - s * akj);
+          a. put (false, k, j, s * aki + c * akj);
+        }
+        FFOR (size_t, k, n)
+        {
+          const Real aik = a. get (false, i, k);
+          const Real ajk = a. get (false, j, k);
+          a. put (false, i, k, c * aik - s * ajk);
+          a. put (false, j, k, s * aik + c * ajk);
+        }
+        FFOR (size_t, k, n)
+        {
+          const Real vki = v. get (false, k, i);
+          const Real vkj = v. get (false, k, j);
+          v. put (false, k, i, c * vki - s * vkj);
+          v. put (false, k, j, s * vki + c * vkj);
+        }
+      }
+  }
+}
+
+}
+
+
+
+void Eigens::subspaceIteration (const Matrix &matr,
+                                size_t dim_max,
+                                Prob totalExplainedFrac_max,
+                                Prob explainedFrac_min,
+                                size_t iter_max,
+                                VectorOwn<Eigen> &vecs)
+{
+  ASSERT (vecs. empty ());
+  
+  const size_t len = matr. rowsSize (false);
+  const size_t dim = min (dim_max, len);
+  const size_t blockSize = min (len, dim + 10);  // PAR
+  if (verbose ())
+    cout << "dim_max = " << dim_max << "  len = " << len << "  blockSize = " << blockSize << endl;
+
+  Rand rand;
+  // Rows are vectors
+  Matrix q  (false, blockSize, len);  
+  Matrix y  (false, blockSize, len);  // = q * matr
+  Matrix u  (false, blockSize, len);  // Ritz vectors
+  Matrix au (false, blockSize, len);  // = u * matr
+  Matrix t (blockSize);
+  Matrix v (blockSize);
+  Matrix vSorted (blockSize);
+  Vector<pair<Real,size_t>> order;  order. reserve (blockSize);
+  Vector<Real> values_;  values_. reserve (blockSize);
+  size_t needed = 0;
+  
+  FFOR (size_t, row, blockSize)
+    q. putRandomRow (false, row, rand);
+  orthonormalizeRows (q, rand);
+  
+  bool converged = false;
+  Progress prog;
+  FFOR (size_t, iter, iter_max)
+  {
+    prog ();
+    
+    y. multiply (false, q, false, matr, false);
+    t. multiply (false, q, false, y, true);
+    {
+      Real maxCorrection;
+      size_t row_bad, col_bad;
+      t. symmetrize (maxCorrection, row_bad, col_bad);
+    }
+    jacobiEigen (t, v);
+
+    // Decreasing values
+    order. clear ();
+    FFOR (size_t, i, blockSize)
+    {
+      const Real value = t. getDiag (i);
+      order << pair<Real,size_t> (psd ? - value : - fabs (value), i);
+    }
+    order. sort ();
+    values_. clear ();
+    FFOR (size_t, col, blockSize)
+    {
+      const size_t i = order [col]. second;
+      values_ << t. getDiag (i);
+      FFOR (size_t, row, blockSize)
+        vSorted. put (false, row, col, v. get (false, row, i));
+    }
+    u.  multiply (false, vSorted, true, q, false);
+    au. multiply (false, vSorted, true, y, false);
+
+    // needed: the stopping criteria of the power iteration
+    needed = 0;
+    explainedFrac_next = NaN;
+    {
+      Real totalExplained = 0.0;
+      while (needed < dim)
+      {
+        Real value = values_ [needed];
+        if (psd)
+        {
+          if (! nullReal (value) && negative (value / totalExplained_max, 1e-2))  // PAR
+            break;
+          maximize (value, 0.0);
+        }
+        const Real explained = psd ? value : sqr (value);
+        explainedFrac_next = explained / totalExplained_max;
+        if (explainedFrac_next < explainedFrac_min)
+          break;
+        totalExplained += explained;
+        if (   totalExplainedFrac_max < 1.0 
+            && totalExplained > totalExplainedFrac_max * totalExplained_max
+           )
+          break;
+        explainedFrac_next = NaN;
+        needed++;
+      }
+    }
+
+    // Convergence: as in Matrix::getEigen()
+    converged = true;
+    FFOR (size_t, i, needed)
+    {
+      const Real value = values_ [i];
+      FFOR (size_t, col, len)
+        if (fabs (au. get (false, i, col) - value * u. get (false, i, col)) > error * fabs (value))
+        {
+          converged = false;
+          break;
+        }
+      if (! converged)
+        break;
+    }
+    if (verbose ())
+      cout << "iter = " << iter << "  needed = " << needed << "  converged = " << converged << endl;
+    if (converged)
+      break;
+
+    q = au;
+    orthonormalizeRows (q, rand);
+  }
+  if (! converged)
+    throw runtime_error (FUNC "The eigenvectors have not converged in " + to_string (iter_max) + " iterations");
+  
+  FFOR (size_t, i, needed)
+  {
+    auto eigen = new Eigen (len);
+    eigen->value = values_ [i];
+    if (psd)
+      maximize (eigen->value, 0.0);
+    FFOR (size_t, col, len)
+      eigen->vec [col] = u. get (false, i, col);
+    EXEC_ASSERT (eigen->vec. normalizeRow (true, 0));
+    eigen->qc ();
+    vecs << eigen;
+  }
+}
+
+
+
 void Eigens::qc () const
 {
   if (! qc_on)
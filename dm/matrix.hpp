@@ -750,6 +750,16 @@ public:
                  const Matrix &m2,
                  bool         t2);
     // *this = m1 * m2
+    // Cache-blocked; multi-threaded if threads_max > 1
+    // Same result as multiplySimple()
+    // Time: O(n^3)
+    // Memory: O(n^2)
+  void multiplySimple (bool         t,
+                       const Matrix &m1, 
+                       bool         t1,
+                       const Matrix &m2,
+                       bool         t2);
+    // Reference implementation of multiply() via multiplyVec()
   void multiplyBilinear (bool         t,
                          const Matrix &m1, 
                          bool         t1,
@@ -1050,9 +1060,11 @@ struct Eigens final : Root
           Prob totalExplainedFrac_max,
           Prob explainedFrac_min,
           Real relError,
-          size_t iter_max);
+          size_t iter_max,
+          bool subspace = false);
     // Randomized algorithm
     // Input: matr: defined(), isSymmetric()
+    //        subspace: use subspaceIteration() instead of matr.getEigen() for each eigenvector
     // Output: totalExplained_max = psd ? matr.getTrace() : matr.sumSqr()
     //         basis: is maximum s.t.:
     //                  rowsSize(true) <= dim_max
@@ -1060,6 +1072,25 @@ struct Eigens final : Root
     //                  explainedFrac() > explainedFrac_min 
     // Invokes: matr.getEigen(error,iter_max)
     // Time: O(n^2 iter_max dim_max)
+private:
+  void subspaceIteration (const Matrix &matr,
+                          size_t dim_max,
+                          Prob totalExplainedFrac_max,
+                          Prob explainedFrac_min,
+                          size_t iter_max,
+                          VectorOwn<Eigen> &vecs);
+    // Randomized block subspace iteration with Rayleigh-Ritz projection
+    // Stops when the eigenvectors satisfying the stopping criteria have converged with error
+    //   else throws after iter_max iterations
+    // Output: vecs
+    // Invokes: Matrix::multiply()
+    // Time: O(n^2 (dim_max + oversampling) iter)
+  void vecs2basis (const Matrix &matr,
+                   VectorOwn<Eigen> &vecs);
+    // Input: matr: from Eigens()
+    // Update: vecs: sorted
+    // Output: basis, values, explainedVarianceFrac
+public:
   Eigens* copy () const final
     { return new Eigens (*this); }
   void qc () const override;
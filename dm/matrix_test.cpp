@@ -51,7 +51,7 @@ namespace
 struct ThisApplication : Application
 {
   ThisApplication ()
-    : Application ("Test matrix.cpp")
+    : Application ("Test matrix.cpp", true, false, true)
     {
       version = VERSION;
       addPositional ("go", "Go");
@@ -246,6 +246,55 @@ struct ThisApplication : Application
 		}
 		
 		
+		// Matrix::multiply() vs. Matrix::multiplySimple()
+		{
+		  Rand rand (seed_global);
+		  const size_t n1 = 137;
+		  const size_t n2 = 211;
+		  const size_t n3 = 98;
+		  Matrix a (false, n1, n2);
+		  Matrix b (false, n2, n3);
+		  FFOR (size_t, row, n1)
+		    FFOR (size_t, col, n2)
+		      a. put (false, row, col, rand. get (100) ? rand. getProb () - 0.5 : NaN);
+		  FFOR (size_t, row, n2)
+		    FFOR (size_t, col, n3)
+		      b. put (false, row, col, rand. get (100) ? rand. getProb () * 10 - 5 : NaN);
+		  FOR (size_t, tA, 2)
+		    FOR (size_t, tB, 2)
+		      FOR (size_t, tC, 2)
+		      {
+		        Matrix a1 (tA, n1, n2);
+		        FFOR (size_t, row, n1)
+		          FFOR (size_t, col, n2)
+		            a1. put (tA, row, col, a. get (false, row, col));
+		        Matrix b1 (tB, n2, n3);
+		        FFOR (size_t, row, n2)
+		          FFOR (size_t, col, n3)
+		            b1. put (tB, row, col, b. get (false, row, col));
+		        Matrix c     (tC, n1, n3);
+		        Matrix cTest (tC, n1, n3);
+		        c.     multiply       (tC, a1, tA, b1, tB);
+		        cTest. multiplySimple (tC, a1, tA, b1, tB);
+		        c. qc ();
+		        ASSERT (c. psd == cTest. psd);
+		        ASSERT (c. maxAbsDiff (false, cTest, false) == 0.0);
+		      }
+		  {
+		    Matrix sq (n2);
+		    sq. multiply (false, a, true, a, false);
+		    ASSERT (sq. psd);
+		    Matrix bil (n3);
+		    bil. multiplyBilinear (false, sq, false, b, false);
+		    Matrix m (false, n2, n3);
+		    m. multiplySimple (false, sq, false, b, false);
+		    Matrix bilTest (n3);
+		    bilTest. multiplySimple (false, b, true, m, false);
+		    ASSERT (bil. psd);
+		    ASSERT (bil. maxAbsDiff (false, bilTest, false) == 0.0);
+		  }
+		}
+		
 		// MATLAB: ~1000 times faster (with 8 cores)
 		{
 			IFStream f ("data/masten_60.mat");
@@ -271,6 +320,25 @@ struct ThisApplication : Application
 	      }
 	    }
 
+      // Eigens: power iteration vs. subspace iteration
+      {
+        const Eigens power    (mat, 10, 1, 0, 1e-5, 10000, false);  // PAR
+        const Eigens subspace (mat, 10, 1, 0, 1e-5, 10000, true);
+        power. qc ();
+        subspace. qc ();
+        ASSERT (power. getDim () == subspace. getDim ());
+        FFOR (size_t, i, power. getDim ())
+        {
+          ASSERT_EQ (power. values [i], subspace. values [i], 1e-3 * power. values [0]);
+          const Real prod = multiplyVec (power. basis, true, i, subspace. basis, true, i);
+          ASSERT_EQ (fabs (prod), 1, 1e-3);
+        }
+        bool converged = true;
+        try { const Eigens unconverged (mat, 10, 1, 0, 1e-5, 1, true); }
+          catch (const runtime_error &) { converged = false; }
+        ASSERT (! converged);
+      }
+
       if (Chronometer::enabled)
       {
 	      const Chronometer_OnePass cop ("sqrt(matrix)");  
@@ -59,7 +59,7 @@ constexpr uint noAttrType = 3;
 struct ThisApplication : Application
 {
   ThisApplication ()
-  : Application ("Multidimensional scaling (linear)")
+  : Application ("Multidimensional scaling (linear)", true, false, true)
   { 
     version = VERSION;
 	  // Input
@@ -71,6 +71,7 @@ struct ThisApplication : Application
 	  addKey ("maxAttr", "Max. # attributes (0 - to be determined automatically)", "100"); 
 	  addKey ("maxTotalExpl", "Min. total explained fraction (0..1)", "1.0");  // was: 0.99
 	  addKey ("minExpl", "Min. explained fraction (0..1)", "0.005");  // was: 0.001
+	  addFlag ("subspace", "Compute the eigenvectors by randomized block subspace iteration, which is faster for large matrices");
 	  // Class attribute
 	  addKey ("class", "Class attribute name");
 	  // Clustering
@@ -93,6 +94,7 @@ struct ThisApplication : Application
 		const size_t maxAttr          = str2<size_t> (getArg ("maxAttr"));          
 		const Prob maxTotalExpl       = str2<Prob>   (getArg ("maxTotalExpl"));     
 		const Prob minExpl            = str2<Prob>   (getArg ("minExpl"));          
+		const bool subspace           =               getFlag ("subspace");
 		//
 		const string classAttrName    =               getArg ("class");             
 		//
@@ -160,6 +162,8 @@ struct ThisApplication : Application
         dist = attr->asRealAttr2 ();
       }
       ASSERT (dist);
+      // Eigens needs a full matrix
+      const_cast <RealAttr2*> (dist) -> unpack ();
       
       if (const PositiveAttr2* distPos = dist->asPositiveAttr2 ())
       {
@@ -172,7 +176,7 @@ struct ThisApplication : Application
   	  {
         Real maxCorrection;
         size_t row_bad, col_bad;
-        const_cast <RealAttr2*> (dist) -> matr. symmetrize (maxCorrection, row_bad, col_bad);
+        const_cast <RealAttr2*> (dist) -> symmetrize (maxCorrection, row_bad, col_bad);
         if (maxCorrection > 2 * pow (10, - (Real) dist->decimals))
           ds. comments << "maxCorrection = " + toString (maxCorrection) + " at " + ds. objs [row_bad] -> name + ", " + ds. objs [col_bad] -> name;
       }
@@ -215,6 +219,7 @@ struct ThisApplication : Application
       }
     }
     ASSERT (sim);
+    sim->unpack ();
 	  if (verbose ())
 	  {
 	    cout << endl;
@@ -271,7 +276,7 @@ struct ThisApplication : Application
     
 
     section ("MDS", false);
-    const Mds mds (sm, *sim, maxAttr, maxTotalExpl, minExpl); 
+    const Mds mds (sm, *sim, maxAttr, maxTotalExpl, minExpl, subspace); 
     mds. qc ();
     mds. saveText (cout);
     cout << endl;
@@ -91,6 +91,7 @@ struct ThisApplication final : Application
     
 
     auto sim_new = new RealAttr2 (attrName, ds_new, 6);  // PAR
+    sim_new->unpack ();
     sim_new->setAll (0);
     Matrix count (false, sim_new->matr, false, 0);
   //count. putAll (0);
@@ -108,6 +109,7 @@ struct ThisApplication final : Application
         const RealAttr2* sim = attr->asRealAttr2 ();
         ASSERT (sim);
 
+        const_cast <RealAttr2*> (sim) -> unpack ();
         Matrix& matr = const_cast <RealAttr2*> (sim) -> matr;
         ASSERT (matr. defined ());
         {
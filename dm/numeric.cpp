@@ -37,6 +37,7 @@
 #include "numeric.hpp"
 
 #include <iostream>
+#include <charconv>
 
 #include "../common.inc"
 
@@ -146,6 +147,27 @@ Real str2real (const string& s)
 
 
 
+Real str2real_fast (string_view s)
+{
+  while (! s. empty () && s. front () == ' ')
+    s. remove_prefix (1);
+  while (! s. empty () && s. back () == ' ')
+    s. remove_suffix (1);
+
+  Real r = NaN;
+  const char* end = s. data () + s. size ();
+  const from_chars_result res = from_chars (s. data (), end, r);
+  if (   res. ec == errc () 
+      && res. ptr == end
+      && r  // 0 is special in str2real()
+     )
+    return r;
+    
+  return str2real (string (s));
+}
+
+
+
 long round (Real a)
 {
   if (isNan (a))
@@ -93,6 +93,10 @@ string real2str (Real x,
 
 Real str2real (const string& s);
 
+Real str2real_fast (string_view s);
+  // Return: = str2real(s)
+  // Faster for usual numbers
+
 constexpr Real inf = numeric_limits<Real>::infinity ();  
 static_assert (inf / 2 == inf);
 static_assert (inf > 0.0);
@@ -56,7 +56,7 @@ const string clusterAttrName = "Cluster";
 struct ThisApplication : Application
 {	
   ThisApplication ()
-  : Application ("Principal components")
+  : Application ("Principal components", true, false, true)
 	{
 	  version = VERSION;
 	  
@@ -66,6 +66,7 @@ struct ThisApplication : Application
 	  addKey ("maxAttr", "Max. # attributes (0 - to be determined automatically)", "100"); 
 	  addKey ("maxTotalExpl", "Min. total explained fraction (0..1)", "1");  // was: 0.99
 	  addKey ("minExpl", "Min. explained fraction (0..1)", "0.005");  // was: 0.001
+	  addFlag ("subspace", "Compute the eigenvectors by randomized block subspace iteration, which is faster for large matrices");
 	  // Class attribute
 	  addKey ("class", "Class attribute name");  // test ??
 	  // Clustering
@@ -90,6 +91,7 @@ struct ThisApplication : Application
 		const uint maxAttr            = str2<uint> (getArg("maxAttr"));
 		const Prob maxTotalExpl       = str2<Prob> (getArg("maxTotalExpl"));
 		const Prob minExpl            = str2<Prob> (getArg("minExpl"));
+		const bool subspace           =             getFlag("subspace");
 		//
 		const bool mds                =             getFlag("mds");
 		const Real outlierEValue      = str2<Real> (getArg("outlierEValue"));
@@ -155,7 +157,7 @@ struct ThisApplication : Application
     }
     	
     section ("PC", false);
-    const PrinComp pc (sm, an. space, mn, maxAttr, maxTotalExpl, minExpl, 1e-4/*PAR*/);
+    const PrinComp pc (sm, an. space, mn, maxAttr, maxTotalExpl, minExpl, 1e-4/*PAR*/, subspace);
     pc. qc ();
     pc. saveText (osPar);
     
@@ -81,13 +81,14 @@ struct ThisApplication final : Application
     }
     ASSERT (sim);    
     ASSERT (! sim->asPositiveAttr2 ());
+    const_cast <RealAttr2*> (sim) -> unpack ();
     
 	
 	  // Check sim->matr  
 	  {
       Real maxCorrection;
       size_t row_bad, col_bad;
-      const_cast <RealAttr2*> (sim) -> matr. symmetrize (maxCorrection, row_bad, col_bad);
+      const_cast <RealAttr2*> (sim) -> symmetrize (maxCorrection, row_bad, col_bad);
       if (maxCorrection > 2 * pow (10, - (Real) sim->decimals))
         ds. comments << "maxCorrection = " + toString (maxCorrection) + " at " + ds. objs [row_bad] -> name + ", " + ds. objs [col_bad] -> name;
     }
@@ -104,6 +105,7 @@ struct ThisApplication final : Application
 	
 
     auto dist = new PositiveAttr2 (sim->name + "_dist", ds, sim->decimals); 
+    dist->unpack ();
     dist->matr = sim->matr;
     dist->matr. similarity2sqrDistance ();
     if (! makeSqr)
@@ -2115,6 +2115,196 @@ bool Tree::strictlyLess_std (const DiGraph::Node* a,
 
 
 
+// CompactTree
+
+CompactTree::CompactTree (const Tree &tree_arg)
+: tree (tree_arg)
+{
+  if (! tree. root)
+    return;
+    
+  const size_t n = tree. nodes. size ();
+  if (n >= (size_t) noIndex)
+    throw runtime_error (FUNC "Too many nodes for CompactTree");
+  nodes.   reserve (n);
+  parents. reserve (n);
+  
+  // Preorder
+  {
+    VectorPtr<Tree::TreeNode> stack;  stack. reserve (n);
+    stack << tree. root;
+    while (! stack. empty ())
+    {
+      const Tree::TreeNode* node = stack. pop ();
+      const Index i = (Index) nodes. size ();
+      var_cast (node) -> compactIndex = i;
+      nodes << node;
+      if (const Tree::TreeNode* parent = node->getParent ())
+        parents << (Index) parent->compactIndex;
+      else
+        parents << noIndex;
+      const List<DiGraph::Arc*>& arcs = node->arcs [false];
+      for (auto it = arcs. rbegin (); it != arcs. rend (); it++)
+        stack << static_cast <const Tree::TreeNode*> ((*it) -> node [false]);
+    }
+  }
+  ASSERT (nodes. size () == n);
+  
+  ends. resize (n);
+  childrenStart. resize (n + 1, 0);
+  FFOR (Index, i, (Index) n)
+    ends [i] = i + 1;
+  for (Index i = (Index) n; i-- > 1;)
+  {
+    const Index parent = parents [i];
+    ASSERT (parent < i);
+    maximize (ends [parent], ends [i]);
+    childrenStart [parent + 1] ++;
+  }
+  FFOR (size_t, i, n)
+    childrenStart [i + 1] += childrenStart [i];
+  ASSERT (childrenStart [n] == n - 1);
+
+  children. resize (n - 1);
+  Vector<Index> next (childrenStart);
+  FFOR_START (Index, i, 1, (Index) n)
+    children [next [parents [i]] ++] = i;
+}
+
+
+
+void CompactTree::qc () const
+{
+  if (! qc_on)
+    return;
+    
+  const size_t n = nodes. size ();
+  QC_ASSERT (n == tree. nodes. size ());
+  QC_ASSERT (parents. size () == n);
+  QC_ASSERT (ends. size () == n);
+  if (! n)
+    return;
+  QC_ASSERT (nodes [0] == tree. root);
+  QC_ASSERT (childrenStart. size () == n + 1);
+  QC_ASSERT (children. size () == n - 1);
+  FFOR (Index, i, (Index) n)
+  {
+    QC_ASSERT (getIndex (nodes [i]) == i);
+    QC_ASSERT (ends [i] > i);
+    QC_ASSERT (ends [i] <= n);
+    QC_ASSERT (isLeaf (i) == nodes [i] -> isLeaf ());
+    FOR_START (Index, j, childrenStart [i], childrenStart [i + 1])
+    {
+      const Index child = children [j];
+      QC_ASSERT (parents [child] == i);
+      QC_ASSERT (nodes [child] -> getParent () == nodes [i]);
+      QC_ASSERT (descendantOf (child, i));
+    }
+  }
+}
+
+
+
+size_t CompactTree::getMemory () const
+{
+  return   nodes.         capacity () * sizeof (nodes [0])
+         + parents.       capacity () * sizeof (Index)
+         + ends.          capacity () * sizeof (Index)
+         + childrenStart. capacity () * sizeof (Index)
+         + children.      capacity () * sizeof (Index);
+}
+
+
+
+void CompactTree::setLeaves () const
+{
+  for (Index i = size (); i-- > 0;)
+  {
+    Tree::TreeNode* node = var_cast (nodes [i]);
+    if (isLeaf (i))
+      node->leaves = 1;
+    else
+    {
+      node->leaves = 0;
+      FOR_START (Index, j, childrenStart [i], childrenStart [i + 1])
+        node->leaves += nodes [children [j]] -> leaves;
+    }
+  }
+}
+
+
+
+Vector<double> CompactTree::getRootDistances () const
+{
+  Vector<double> dists (nodes. size (), 0.0);
+  FFOR_START (Index, i, 1, size ())
+    dists [i] = dists [parents [i]] + nodes [i] -> getParentDistance ();
+  return dists;
+}
+
+
+
+
+// TreeLca
+
+TreeLca::TreeLca (const Tree &tree)
+: ct (tree)
+{
+  const Index n = ct. size ();
+  if (! n)
+    return;
+  
+  depths. resize (n, 0);
+  FFOR_START (Index, i, 1, n)
+    depths [i] = depths [ct. parents [i]] + 1;
+    
+  logs. resize (n, 0);
+  FFOR_START (Index, i, 2, n)
+    logs [i] = (uint8_t) (logs [i / 2] + 1);
+    
+  table. resize ((size_t) logs [n - 1] + 1);
+  table [0]. resize (n);
+  FFOR (Index, i, n)
+    table [0] [i] = i;
+  FFOR_START (size_t, k, 1, table. size ())
+  {
+    const Vector<Index>& prev = table [k - 1];
+    Vector<Index>& cur = table [k];
+    const Index half = (Index) 1 << (k - 1);
+    cur. resize (n - 2 * half + 1);
+    FFOR (Index, i, (Index) cur. size ())
+    {
+      const Index a = prev [i];
+      const Index b = prev [i + half];
+      cur [i] = depths [a] <= depths [b] ? a : b;
+    }
+  }
+}
+
+
+
+void TreeLca::qc () const
+{
+  if (! qc_on)
+    return;
+  ct. qc ();
+  
+  const Index n = ct. size ();
+  QC_ASSERT (depths. size () == n);
+  Tree::LcaBuffer buf;
+  const Index step = max<Index> (1, n / 100);  // PAR
+  for (Index i = 0; i < n; i += step)
+    for (Index j = 0; j < n; j += step)
+    {
+      const Tree::TreeNode* lca = Tree::getLca (ct. nodes [i], ct. nodes [j], buf);
+      QC_ASSERT (ct. nodes [getLca (i, j)] == lca);
+      QC_ASSERT (getDepth (getLca (i, j)) <= min (getDepth (i), getDepth (j)));
+    }
+}
+
+
+
+
 // TopologicalSort
 
 TopologicalSort::TopologicalSort (DiGraph &graph_arg,
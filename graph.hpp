@@ -323,6 +323,8 @@ struct Tree : DiGraph
 	  size_t frequentDegree {0};
 	    // For an undirected tree
 	  size_t leaves {0};
+	  size_t compactIndex {no_index};
+	    // Index in CompactTree::nodes of the last CompactTree of getTree()
 
 		TreeNode (Tree &tree,
 		          TreeNode* parent)
@@ -659,6 +661,7 @@ struct Tree : DiGraph
                                  const TreeNode* n2,
                                  LcaBuffer &buf);
     // Return: nullptr <=> !n1 || !n2
+    // Time: O(depth)
   static const TreeNode* getLca (const VectorPtr<TreeNode> &nodeVec,   
 	                               Tree::LcaBuffer &buf);
     // Return: nullptr <= nodeVec.empty()
@@ -721,6 +724,109 @@ public:
 
 
 
+struct CompactTree : Root
+// Immutable index-based view of a Tree: contiguous arrays of 32-bit indexes instead of pointer-linked Arc's
+// Index of a TreeNode: its number in the depth-first preorder, root = 0
+// The subtree of index i = [i, ends[i])
+// Invalid after a change of the topology of tree
+// Time of construction: O(n)
+{
+  typedef  uint32_t  Index;
+  static constexpr Index noIndex {numeric_limits<Index>::max ()};
+  
+  const Tree& tree;
+  VectorPtr<Tree::TreeNode> nodes;
+    // Index: Index
+    // !nullptr
+  Vector<Index> parents;
+    // noIndex <=> root
+  Vector<Index> ends;
+    // Index: Index
+  Vector<Index> childrenStart;
+    // size() = nodes.size() + 1
+  Vector<Index> children;
+    // Children of index i: children[childrenStart[i] .. childrenStart[i+1]-1], in the order of TreeNode::arcs[false]
+    // size() = nodes.size() - 1
+  
+  
+  explicit CompactTree (const Tree &tree_arg);
+    // Output: TreeNode::compactIndex
+  void qc () const override;
+  
+  
+  Index size () const
+    { return (Index) nodes. size (); }
+  Index getIndex (const Tree::TreeNode* node) const
+    { return (Index) node->compactIndex; }
+    // Requires: nodes.contains(node)
+  bool isLeaf (Index i) const
+    { return childrenStart [i] == childrenStart [i + 1]; }
+  bool descendantOf (Index i,
+                     Index ancestor) const
+    { return    ancestor <= i 
+             && i < ends [ancestor]; 
+    }
+    // Time: O(1)
+  size_t getMemory () const;
+    // Return: bytes
+  void setLeaves () const;
+    // Output: TreeNode::leaves as in Tree::setLeaves()
+    // Time: O(n)
+  Vector<double> getRootDistances () const;
+    // Return: Index -> TreeNode::getRootDistance()
+    // Invokes: TreeNode::getParentDistance()
+    // Time: O(n)
+};
+
+
+
+struct TreeLca : Root
+// Lowest common ancestor in O(1) by the range minimum query of depths over CompactTree indexes:
+//   LCA of indexes i < j = parent of an index with the smallest depth in (i,j]
+// Invalid after a change of the topology of ct.tree
+// Time of construction: O(n log(n))
+{
+  typedef  CompactTree::Index  Index;
+  
+  const CompactTree ct;
+private:
+  Vector<Index> depths;
+    // Index: Index
+  Vector<Vector<Index>> table;
+    // table[k][i] = an index with the smallest depth in [i, i + 2^k)
+  Vector<uint8_t> logs;
+    // logs[i] = floor(log_2(i))
+public:
+  
+  
+  explicit TreeLca (const Tree &tree);
+    // Output: TreeNode::compactIndex
+  void qc () const override;
+  
+
+  Index getLca (Index i,
+                Index j) const
+    { if (i == j)
+        return i;
+      if (i > j)
+        swap (i, j);
+      const uint8_t k = logs [j - i];
+      const Index a = table [k] [i + 1];
+      const Index b = table [k] [j + 1 - ((Index) 1 << k)];
+      return ct. parents [depths [a] <= depths [b] ? a : b];
+    }
+    // Time: O(1)
+  const Tree::TreeNode* getLca (const Tree::TreeNode* n1,
+                                const Tree::TreeNode* n2) const
+    { return ct. nodes [getLca (ct. getIndex (n1), ct. getIndex (n2))]; }
+    // Requires: ct.nodes.contains(n1), ct.nodes.contains(n2)
+    // Time: O(1)
+  Index getDepth (Index i) const
+    { return depths [i]; }
+};
+
+
+
 struct TopologicalSort : Root
 // Usage: 
 //   while (Node* n = ts.getFront ())  ...
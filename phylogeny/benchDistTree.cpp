@@ -0,0 +1,127 @@
+// benchDistTree.cpp
+
+/*===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+* Author: Vyacheslav Brover
+*
+* File Description:
+*   Benchmark of distance tree reductions over dissimilarities
+*
+*/
+
+
+#undef NDEBUG
+
+#include "../common.hpp"
+using namespace Common_sp;
+#include "distTree.hpp"
+using namespace DistTree_sp;
+#include "../version.inc"
+
+#include "../common.inc"
+
+
+
+namespace
+{
+
+
+
+struct ThisApplication : Application
+{
+	ThisApplication ()
+	: Application ("Benchmark of distance tree reductions over dissimilarities.\nPrint: <reduction> <sec. per iteration> <abs. criterion>", true, false, true)
+	{
+	  version = VERSION;
+    // Input
+	  addKey ("input_tree", "Tree file");
+	  addPositional ("data", dmSuff + "-file without " + strQuote (dmSuff));
+	  addKey ("dissim_attr", "Dissimilarity attribute name in the <data> file");
+	  addKey ("variance", "Dissimilarity variance: " + varianceTypeNames. toString (" | "), varianceTypeNames [varianceType]);
+	  addKey ("variance_power", "Power for -variance pow; > 0", "NaN");
+	  addKey ("iter", "Number of iterations of each reduction", "10");
+	}
+
+
+
+	void body () const final
+  {
+	  const string input_tree     = getArg ("input_tree");
+	  const string dataFName      = getArg ("data");
+	  const string dissimAttrName = getArg ("dissim_attr");
+	               varianceType   = str2varianceType (getArg ("variance"));  // Global
+	               variancePower  = str2real (getArg ("variance_power"));    // Global
+	  const size_t iter           = str2<size_t> (getArg ("iter"));
+
+		if (! isNan (variancePower) && varianceType != varianceType_pow)
+		  throw runtime_error ("-variance_power requires -variance pow");
+		if (isNan (variancePower) && varianceType == varianceType_pow)
+		  throw runtime_error ("-variance_power is needed by -variance pow");
+		if (variancePower <= 0.0)
+		  throw runtime_error ("-variance_power must be positive");
+		if (! iter)
+		  throw runtime_error ("-iter must be positive");
+
+
+    const DissimParam dissimParam;
+
+    unique_ptr<DistTree> tree;
+    tree. reset (input_tree. empty ()
+                   ? new DistTree (dissimParam,             dataFName, dissimAttrName, noString)
+                   : new DistTree (dissimParam, input_tree, dataFName, dissimAttrName, noString)
+                );
+    tree->qc ();
+    QC_ASSERT (tree->optimizable ());
+
+    const ONumber on (cout, 6, true);  // PAR
+    const auto bench = [iter] (const string &name,
+                               const auto &reduction)
+      { Real absCriterion = NaN;
+        const auto start = chrono::steady_clock::now ();
+        FOR (size_t, i, iter)
+          absCriterion = reduction ();
+        const double t = chrono::duration<double> (chrono::steady_clock::now () - start). count ();
+        cout << name << '\t' << t / (double) iter << '\t' << absCriterion << endl;
+      };
+    bench ("getDissimSums",    [&tree] () { return tree->getDissimSums (). absCriterion; });
+    bench ("setDissimMult",    [&tree] () { tree->setDissimMult (true);  return tree->absCriterion; });
+    bench ("optimizeLenWhole", [&tree] () { tree->optimizeLenWhole ();   return tree->absCriterion; });
+    tree->qc ();
+	}
+};
+
+
+
+}  // namespace
+
+
+
+
+int main (int argc,
+          const char* argv[])
+{
+  ThisApplication app;
+  return app. run (argc, argv);
+}
@@ -0,0 +1,130 @@
+// benchFeatureTree.cpp
+
+/*===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+* Author: Vyacheslav Brover
+* Author: Vyacheslav Brover
+*
+* File Description:
+*   Benchmark of the parsimony method of a feature tree
+*
+*/
+
+
+#undef NDEBUG
+
+#include "../common.hpp"
+using namespace Common_sp;
+#include "../dm/numeric.hpp"
+using namespace DM_sp;
+#include "featureTree.hpp"
+using namespace FeatureTree_sp;
+#include "../version.inc"
+
+#include "../common.inc"
+
+
+
+namespace 
+{
+
+
+
+struct ThisApplication : Application
+{
+	ThisApplication ()
+  	: Application ("Benchmark of the parsimony method of a feature tree processing features one by one in the tree: per-feature vs. bit-sliced Sankoff algorithm.\nPrint: <method> <sec.> <tree length>", true, false, true)
+  	{
+  	  version = VERSION;
+  	  
+  	  addKey ("input_tree", "Input file with the tree without time");
+  	  addKey ("features", "Input directory with features for each genome. Line format: " + Genome::featureLineFormat ());
+  	  addFlag ("large", "Featrue files are grouped into subdirectories which are their hash-names (hash<string> % 1000)");
+  	  addFlag ("nominal_singleton_is_optional", "Nominal singleton value means that all values of this nominal attribute are optional for the genome");
+  	  addFlag ("prefer_gain", "Prefer gain over loss in maximum parsimony method");
+  	}
+
+
+
+	void body () const final
+  {
+		const string input_tree  = getArg ("input_tree");
+		const string feature_dir = getArg ("features");
+		const bool   large       = getFlag ("large");
+		const bool   nominal_singleton_is_optional = getFlag ("nominal_singleton_is_optional");
+		const bool   prefer_gain = getFlag ("prefer_gain");
+		
+
+    const ONumber on (cout, 6, true);  // PAR
+    unique_ptr<const FeatureTree> trees [2/*parsimonyBitSliced*/];
+    for (const bool bitSliced : {false, true})
+    {
+      parsimonyBitSliced = bitSliced;  // Global
+      const auto start = chrono::steady_clock::now ();
+      trees [bitSliced]. reset (new FeatureTree (input_tree, feature_dir, large, noString, nominal_singleton_is_optional, prefer_gain, true));
+      const double t = chrono::duration<double> (chrono::steady_clock::now () - start). count ();
+      const FeatureTree& tree = * trees [bitSliced];
+      tree. qc ();
+      if (! tree. allTimeZero)
+        throw runtime_error ("The tree must have no time: maximum parsimony method");
+      QC_ASSERT (tree. parsimonyBits () == bitSliced);
+      cout << (bitSliced ? "bit-sliced" : "per-feature") << '\t' << t << '\t' << tree. len << endl;
+    }
+    
+    const FeatureTree& tree0 = * trees [false];
+    const FeatureTree& tree1 = * trees [true];
+    if (! eqReal (tree0. len, tree1. len))
+      throw runtime_error ("Different tree lengths");
+    QC_ASSERT (tree0. features. size () == tree1. features. size ());
+    FFOR (size_t, i, tree0. features. size ())
+    {
+      const Feature& f0 = tree0. features [i];
+      const Feature& f1 = tree1. features [i];
+      QC_ASSERT (f0. name == f1. name);
+      if (! (   f0. gains.  size ()    == f1. gains.  size ()
+             && f0. losses. size ()    == f1. losses. size ()
+             && f0. genomes            == f1. genomes
+             && f0. optionalGenomes    == f1. optionalGenomes
+             && f0. rootGain           == f1. rootGain
+            )
+         )
+        throw runtime_error ("Different statistics of feature " + strQuote (f0. name));
+    }
+	}
+};
+
+
+
+}  // namespace
+
+
+
+
+int main (int argc, 
+          const char* argv[])
+{
+  ThisApplication app;
+  return app. run (argc, argv);
+}
@@ -99,108 +99,111 @@ Leaves tree2leaves (const Tree &tree)
 
   
   
-map <const Tree::TreeNode*, Leaves> node2leaves;
+typedef  uint64_t  Fingerprint;
+
+
+
+Vector<Fingerprint> getLeafFingerprints (size_t leaves)
+// Return: random, size() = leaves
+{
+  Rand rand;
+  Vector<Fingerprint> fingerprints;  fingerprints. reserve (leaves);
+  FFOR (size_t, i, leaves)
+    fingerprints << ((rand. get () << 32) ^ rand. get ());
+  return fingerprints;
+}
+
+
+
+struct Split
+// Of the leaves by the arc to a node
+{
+  size_t leaves {0};
+    // # Leaves in the subtree
+  Fingerprint fingerprint {0};
+    // XOR of the leaf fingerprints of the subtree
+    // Collision probability ~ (# splits)^2 / 2^62
+  bool hasFront {false};
+    // The subtree contains the first leaf
+    
+  bool operator< (const Split &other) const
+    { LESS_PART (*this, other, leaves);
+      LESS_PART (*this, other, fingerprint);
+      return false;
+    }
+};
+
+
+
+unordered_map <const Tree::TreeNode*, Split> node2split;
   // For all Tree's
 
 
 
-void setNode2leaves (const Tree::TreeNode* node)
-// Output: node2leaves
+void setNode2split (const Tree::TreeNode* node,
+                    const Leaves &allLeaves,
+                    const Vector<Fingerprint> &leafFingerprints)
+// Output: node2split
 {
   ASSERT (node);
-  ASSERT (node2leaves [node]. empty ());
+  Split& split = node2split [node];
+  ASSERT (! split. leaves);
   if (node->isLeafType ())
-    node2leaves [node] << node->getName ();
+  {
+    const size_t i = allLeaves. binSearch (node->getName ());
+    ASSERT (i != no_index);
+    split. leaves = 1;
+    split. fingerprint = leafFingerprints [i];
+    split. hasFront = ! i;
+  }
   else 
   	for (const DiGraph::Arc* arc : node->arcs [false])
   	{
   	  const Tree::TreeNode* child = static_cast <const Tree::TreeNode*> (arc->node [false]);
-  	  setNode2leaves (child);
-  	  node2leaves [node] << node2leaves [child];
+  	  setNode2split (child, allLeaves, leafFingerprints);
+  	  const Split& childSplit = node2split [child];
+  	  split. leaves      += childSplit. leaves;
+  	  split. fingerprint ^= childSplit. fingerprint;
+  	  if (childSplit. hasFront)
+  	    split. hasFront = true;
   	}
-  node2leaves [node]. sort ();
-  ASSERT (node2leaves [node]. isUniq ());
 }
 
 
 
-void adjustNode2leaves (const Tree &tree,
-                        const Leaves &allLeaves)
-// Update: node2leaves
+void adjustNode2split (const Tree &tree,
+                       const Leaves &allLeaves,
+                       const Vector<Fingerprint> &leafFingerprints)
+// Update: node2split: the smaller part of the split
 {
   ASSERT (allLeaves. ascending == etrue);
+  ASSERT (leafFingerprints. size () == allLeaves. size ());
   
  	const size_t all = allLeaves. size ();
-  for (auto& it : node2leaves)
+ 	Fingerprint allFingerprint = 0;
+ 	for (const Fingerprint fp : leafFingerprints)
+ 	  allFingerprint ^= fp;
+ 	  
+ 	for (const DiGraph::Node* node_ : tree. nodes)  
   {
-    const Tree::TreeNode* node = it. first;
-    ASSERT (node->graph);
-    if (& node->getTree () != & tree)
-      continue;
-    Leaves& leaves = it. second;
-  	const size_t size = leaves. size ();
-  	ASSERT (size <= all);
-  	if (   size > all / 2
-  	    || (even (all) && size == all / 2 && ! leaves. containsFast (allLeaves. front ()))
+ 	  const Tree::TreeNode* node = static_cast <const Tree::TreeNode*> (node_);
+    Split& split = node2split [node];
+  	ASSERT (split. leaves <= all);
+  	if (   split. leaves > all / 2
+  	    || (even (all) && split. leaves == all / 2 && ! split. hasFront)
   	   )
   	{
-  	  Leaves s (allLeaves);
-      ASSERT (s. ascending == etrue);  
-      ASSERT (leaves. ascending == etrue);  
-  	  s. setMinus (leaves);
-  	  leaves = s;
-      ASSERT (leaves. ascending == etrue);  
+  	  split. leaves = all - split. leaves;
+  	  split. fingerprint ^= allFingerprint;
+  	  split. hasFront = ! split. hasFront;
   	}
-  	ASSERT (leaves. size () <= all / 2);
-  	IMPLY (even (all) && leaves. size () == all / 2, leaves. containsFast (allLeaves. front ()));
+  	ASSERT (split. leaves <= all / 2);
+  	IMPLY (even (all) && split. leaves == all / 2, split. hasFront);
   }
 }
 
 
 
-struct Signature
-{
-  size_t leaves {0};
-  string front;
-  string back;
-  
-  Signature () = default;
-  Signature (size_t leaves_arg,
-             const string &front_arg,
-             const string &back_arg)
-    : leaves (leaves_arg)
-    , front (front_arg)
-    , back (back_arg)
-    { ASSERT (leaves);
-      ASSERT (! front. empty ());
-      ASSERT (! back.  empty ()); 
-    }    
-};
-
-
-
-bool operator< (const Signature &a,
-                const Signature &b)
-{ 
-  LESS_PART (a, b, leaves);
-  LESS_PART (a, b, front);
-  LESS_PART (a, b, back);
-  return false;
-}
-
-
-
-Signature leaves2signature (const Leaves &leaves)
-{
-  ASSERT (leaves. ascending == etrue);
-  return leaves. empty () 
-           ? Signature ()
-           : Signature (leaves. size (), leaves. front (), leaves. back ());
-}
-
-
-
-
 //
 
 struct ThisApplication : Application
@@ -316,52 +319,40 @@ struct ThisApplication : Application
    	}
 
     
-    setNode2leaves (tree1->root);
-    setNode2leaves (tree2->root); 
     {
       const Leaves allLeaves (tree2leaves (*tree1));  // Same for *tree2
-      adjustNode2leaves (*tree1, allLeaves);   
-      adjustNode2leaves (*tree2, allLeaves);   
+      const Vector<Fingerprint> leafFingerprints (getLeafFingerprints (allLeaves. size ()));
+      node2split. rehash (tree1->nodes. size () + tree2->nodes. size ());
+      setNode2split (tree1->root, allLeaves, leafFingerprints);
+      setNode2split (tree2->root, allLeaves, leafFingerprints);
+      adjustNode2split (*tree1, allLeaves, leafFingerprints);   
+      adjustNode2split (*tree2, allLeaves, leafFingerprints);   
     }
 
-    map <Signature, VectorPtr<Tree::TreeNode>> signature2nodes2;  // tree2
-   	for (const DiGraph::Node* node2_ : tree2->nodes)  
-   	{
-   	  const Tree::TreeNode* node2 = static_cast <const Tree::TreeNode*> (node2_);
-   	  signature2nodes2 [leaves2signature (node2leaves [node2])] << node2;
-   	}
+    Set<Split> splits2;  
+   	for (const DiGraph::Node* node2 : tree2->nodes)  
+   	  splits2 << node2split [static_cast <const Tree::TreeNode*> (node2)];
 
-
-    map <const Tree::TreeNode* /*tree1*/, const Tree::TreeNode* /*tree2*/> node2node;  
-      // key: !nullptr
-      // value: not deterministic <= Leaf's in tree2 are removed 
+    Set<const Tree::TreeNode* /*tree1*/> matches;  
    	for (const Tree::TreeNode* node1 : interiorArcNodes1)  
    	{
    	  ASSERT (node1);
-   		const Signature sig (leaves2signature (node2leaves [node1]));
-      if (sig. leaves)
-      {
-	   	  const VectorPtr<Tree::TreeNode> nodes2 (signature2nodes2 [sig]);
-	   	  for (const Tree::TreeNode* node2 : nodes2)
-	     	  if (node2leaves [node1] == node2leaves [node2])
-	   	    {
-	 	        node2node [node1] = node2;
-	   	      break;  
-	   	    }
-	   	}
-	   	else /*if (! skip_empty)*/
-	   		node2node [node1] = nullptr;
+   		const Split& split = node2split [node1];
+      if (   ! split. leaves  
+          || splits2. contains (split)
+         )
+        matches << node1;
    	}
 
    	
    	MeanVar mv;
    	for (const Tree::TreeNode* node1 : interiorArcNodes1)  
    	{
-      cout << "match" << (contains (node2node, node1) ? '+' : '-') 
+      cout << "match" << (matches. contains (node1) ? '+' : '-') 
       	   << '\t' << getNodeName (node1);
       if (arc_info)
       	cout 
-      	   << '\t' << node2leaves [node1]. size ()
+      	   << '\t' << node2split [node1]. leaves
       	   << '\t' << node1->getParentDistance ()
       	   << '\t' << node1->getRootDistance ();
       cout << endl;
@@ -0,0 +1,115 @@
+// dissimBin.cpp
+
+/*===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE                          
+*               National Center for Biotechnology Information
+*                                                                          
+*  This software/database is a "United States Government Work" under the   
+*  terms of the United States Copyright Act.  It was written as part of    
+*  the author's official duties as a United States Government employee and 
+*  thus cannot be copyrighted.  This software/database is freely available 
+*  to the public for use. The National Library of Medicine and the U.S.    
+*  Government have not placed any restriction on its use or reproduction.  
+*                                                                          
+*  Although all reasonable efforts have been taken to ensure the accuracy  
+*  and reliability of the software and data, the NLM and the U.S.          
+*  Government do not and cannot warrant the performance or results that    
+*  may be obtained by using this software or data. The NLM and the U.S.    
+*  Government disclaim all warranties, express or implied, including       
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.                                                                
+*                                                                          
+*  Please cite the author in any work or product based on this material.   
+*
+* ===========================================================================
+*
+* Author: Vyacheslav Brover
+*
+* File Description:
+*   Binary dissimilarity file: import, export, compaction
+*
+*/
+
+
+
+#undef NDEBUG
+
+#include "../common.hpp"
+using namespace Common_sp;
+#include "distTree.hpp"
+using namespace DistTree_sp;
+#include "../version.inc"
+
+#include "../common.inc"
+
+
+
+namespace 
+{
+  
+ 
+struct ThisApplication : Application
+{
+	ThisApplication ()
+	: Application ("Maintain a binary dissimilarity file used by an incremental distance tree instead of a text dissimilarity file")
+	{
+	  version = VERSION;
+	  addPositional ("bin", "Binary dissimilarity file");
+	  addKey ("add", "Text dissimilarity file to be appended to <bin>, line format: <obj1> <obj2> <dissimilarity>; <bin> is created if it does not exist");
+	  addFlag ("compact", "Rewrite <bin> as one block of names and one block of dissimilarities");
+	  addFlag ("text", "Print <bin> in the text format: <obj1> <obj2> <dissimilarity>");
+	}
+	
+	
+	
+	void body () const final
+  {
+	  const string binFName = getArg ("bin");
+	  const string addFName = getArg ("add");
+	  const bool   compactP = getFlag ("compact");
+	  const bool   textP    = getFlag ("text");
+	  
+	  QC_ASSERT (! binFName. empty ());
+	  
+	  
+	  if (! addFName. empty ())
+	    DissimBin::append (binFName, addFName);
+	    
+	  if (! fileExists (binFName))
+	    throw runtime_error ("File " + shellQuote (binFName) + " does not exist");
+	    
+	  if (compactP)
+	    DissimBin::compact (binFName);
+	    
+	  if (textP)
+	  {
+	    const DissimBin db (binFName);
+	    db. saveText (cout);
+	  }
+	  
+	  if (verbose ())
+	  {
+	    const DissimBin db (binFName);
+	    size_t records = 0;
+	    for (const auto& block : db. blocks)
+	      records += block. second;
+	    cerr << "# Names: " << db. names. size () << endl;
+	    cerr << "# Blocks: " << db. blocks. size () << endl;
+	    cerr << "# Records: " << records << endl;
+	  }
+	}
+};
+
+
+
+}  // namespace
+
+
+
+int main (int argc, 
+          const char* argv[])
+{
+  ThisApplication app;
+  return app. run (argc, argv);
+}
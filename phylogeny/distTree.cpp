@@ -34,6 +34,11 @@
 
 #undef NDEBUG
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <shared_mutex>
+
 #include "distTree.hpp"
 
 #include "../dm/prediction.hpp"
@@ -61,6 +66,8 @@ VarianceType varianceType = varianceType_none;
 Real variancePower = NaN;
 Real variance_min = 0.0;
 
+size_t subgraphs_memory_max = 0;
+
 
 
 
@@ -693,6 +700,181 @@ void TriangleParentPair::setChildrenHybrid ()
 
 
 
+// DissimNums
+
+DissimNums& DissimNums::operator<< (const DissimNums &other)
+{
+  unpack ();
+  vec. reserveInc (other. size ());
+  for (const uint dissimNum : other)
+    vec << dissimNum;
+  return *this;
+}
+
+
+
+void DissimNums::uniq ()
+{
+  if (! packed ())
+    vec. uniq ();
+  else if (! isUniq ())
+  {
+    unpack ();
+    vec. uniq ();
+  }
+}
+
+
+
+bool DissimNums::isUniq () const
+{
+  if (! packed ())
+    return vec. isUniq ();
+
+  bool first = true;
+  uint prev = 0;
+  for (const uint dissimNum : *this)
+  {
+    if (! first && dissimNum == prev)
+      return false;
+    first = false;
+    prev = dissimNum;
+  }
+  return true;
+}
+
+
+
+bool DissimNums::contains (uint dissimNum) const
+{
+  if (packed ())
+    return containsFast (dissimNum);
+  return vec. contains (dissimNum);
+}
+
+
+
+bool DissimNums::containsFast (uint dissimNum) const
+{
+  if (! packed ())
+    return vec. containsFast (dissimNum);
+
+  // Last block whose first dissimNum <= dissimNum
+  const uint8_t* data = & packedData [0];
+  size_t lo = 0;
+  size_t hi = blocks ();
+  while (lo + 1 < hi)
+  {
+    const size_t mid = (lo + hi) / 2;
+    if (read32 (data + read32 (data + mid * sizeof (uint))) <= dissimNum)
+      lo = mid;
+    else
+      hi = mid;
+  }
+
+  const size_t blockStart = lo * block_size;
+  const_iterator it (data + read32 (data + lo * sizeof (uint)), min<size_t> (block_size, packedSize - blockStart) + 1);
+  for (; it != end (); ++it)
+    if (*it >= dissimNum)
+      return *it == dissimNum;
+  return false;
+}
+
+
+
+bool DissimNums::intersectsFast_merge (const DissimNums &other) const
+{
+  const_iterator it1 (begin ());
+  const_iterator it2 (other. begin ());
+  const const_iterator end1 (end ());
+  const const_iterator end2 (other. end ());
+  while (it1 != end1 && it2 != end2)
+    if (*it1 == *it2)
+      return true;
+    else if (*it1 < *it2)
+      ++it1;
+    else
+      ++it2;
+  return false;
+}
+
+
+
+void DissimNums::pack ()
+{
+  if (packed ())
+    return;
+  if (vec. size () < pack_min)
+    return;
+  QC_ASSERT (vec. size () <= (size_t) numeric_limits<uint>::max ());
+
+  vec. sort ();
+
+  // Bytes
+  packedSize = (uint) vec. size ();
+  size_t bytes = blocks () * sizeof (uint);
+  FFOR (size_t, i, vec. size ())
+    if (i % block_size)
+    {
+      uint delta = vec [i] - vec [i - 1];
+      do
+      {
+        bytes++;
+        delta >>= 7;
+      }
+      while (delta);
+    }
+    else
+      bytes += sizeof (uint);
+  QC_ASSERT (bytes <= (size_t) numeric_limits<uint>::max ());
+
+  packedData. resize (bytes);
+  packedData. shrink_to_fit ();
+  uint8_t* data = & packedData [0];
+  uint8_t* pos = data + blocks () * sizeof (uint);
+  FFOR (size_t, i, vec. size ())
+    if (i % block_size)
+    {
+      uint delta = vec [i] - vec [i - 1];
+      while (delta >= 0x80)
+      {
+        *pos++ = (uint8_t) (delta | 0x80);
+        delta >>= 7;
+      }
+      *pos++ = (uint8_t) delta;
+    }
+    else
+    {
+      const uint offset = (uint) (pos - data);
+      memcpy (data + i / block_size * sizeof (uint), & offset, sizeof (offset));
+      memcpy (pos, & vec [i], sizeof (uint));
+      pos += sizeof (uint);
+    }
+  ASSERT (pos == data + bytes);
+
+  vec. wipe ();
+}
+
+
+
+void DissimNums::unpack ()
+{
+  if (! packed ())
+    return;
+
+  ASSERT (vec. empty ());
+  vec. reserve (packedSize);
+  for (const uint dissimNum : *this)
+    vec << dissimNum;
+  vec. ascending = etrue;
+
+  packedData. wipe ();
+  packedSize = 0;
+}
+
+
+
+
 //
 
 static const string lenS               ("len");
@@ -953,16 +1135,6 @@ void DTNode::setSubtreeLeaves ()
 
 
 
-void DTNode::setLca ()
-{
-  ASSERT (getDisjointCluster () == this);
-  ASSERT (! tarjanLca);    
-
-  tarjanLca = this;
-}
-
-
-
 Vector<uint> DTNode::getLcaDissimNums () 
 {
   Vector<uint> lcaObjNums;  
@@ -978,7 +1150,7 @@ Vector<uint> DTNode::getLcaDissimNums ()
   const VectorPtr<DiGraph::Node> children (getChildren ());
   FOR_REV (size_t, i, children. size ())
   {
-    Vector<uint>& childPathObjNums = const_static_cast <DTNode*> (children [i]) -> pathDissimNums;
+    DissimNums& childPathObjNums = const_static_cast <DTNode*> (children [i]) -> pathDissimNums;
   #if 0
     // Faster for small n
     for (const size_t dissimNum : childPathObjNums)
@@ -1230,23 +1402,6 @@ void Steiner::getDescendants (VectorPtr<DTNode> &descendants,
 
 
 
-void Steiner::setLca ()
-{
-  DTNode::setLca ();
-
-  for (DiGraph::Arc* arc : arcs [false])
-  {
-    DTNode* child = static_cast <DTNode*> (arc->node [false]);
-    child->setLca ();  // DFS
-    DisjointCluster::merge (*child);
-    DTNode* cluster = static_cast <DTNode*> (getDisjointCluster ());
-    ASSERT (cluster);
-    cluster->tarjanLca = this;
-  }
-}
-
-
-
 void Steiner::reverseParent (const Steiner* target, 
                              Steiner* child)
 {
@@ -1643,32 +1798,6 @@ void Leaf::saveContent (ostream& os) const
 
 
 
-void Leaf::setLca ()
-{
-  DTNode::setLca ();
-
-  for (const uint dissimNum : pathDissimNums)
-  {
-    const Leaf* other = getDissimOther (dissimNum);
-    ASSERT (other != this);
-    if (! other->graph)
-      continue;
-    if (! other->tarjanLca)
-      continue;
-    DTNode* cluster = static_cast <DTNode*> (var_cast (other) -> getDisjointCluster ());
-    ASSERT (cluster);
-    const DTNode* lca = cluster->tarjanLca;
-    ASSERT (lca);
-    const Steiner* st = lca->asSteiner ();
-    ASSERT (st);
-    const Dissim& dissim = getDistTree (). dissims [dissimNum];
-    ASSERT (! dissim. lca);
-    var_cast (dissim). lca = st;
-  }
-}
-
-
-
 const Leaf* Leaf::getDissimOther (size_t dissimNum) const
 { 
   const Dissim& dissim = getDistTree (). dissims [dissimNum];
@@ -2049,7 +2178,7 @@ void Subgraph::dissimNums2subPaths ()
   for (const Tree::TreeNode* node : boundary)  
   {
     const DTNode* dtNode = static_cast <const DTNode*> (node);
-    const Vector<uint>& pathDissimNums = boundary2pathDissimNums (dtNode);
+    const DissimNums& pathDissimNums = boundary2pathDissimNums (dtNode);
     for (const uint dissimNum : pathDissimNums)
     {
       if (! tree. dissims [dissimNum]. valid ())  
@@ -2128,15 +2257,15 @@ Real Subgraph::getImprovement (const DiGraph::Node2Node &boundary2new) const
 namespace
 {
   
-void subPath2tree_dissim (Subgraph &subgraph,
-                          const SubPath &subPath,
-                          Tree::LcaBuffer &buf,
-                          Real &absCriterion
-                        #ifdef MUTEX
-                         ,bool threadsUsed
-                        #endif
-                         )
-// Update: absCriterion
+void subPath2tree_path (Subgraph &subgraph,
+                        const SubPath &subPath,
+                        Tree::LcaBuffer &buf,
+                        Subgraph::SubPathTree &subPathTree
+                      #ifdef MUTEX
+                       ,bool threadsUsed
+                      #endif
+                       )
+// Output: subPathTree
 {
   subPath. qc ();
   ASSERT (subPath. node1->graph == & subgraph. tree);
@@ -2145,12 +2274,11 @@ void subPath2tree_dissim (Subgraph &subgraph,
   const Tree::TreeNode* lca_ = nullptr;
   const VectorPtr<Tree::TreeNode>& path = Tree::getPath (subPath. node1, subPath. node2, subgraph. area_root, lca_, buf);
   ASSERT (lca_);
-  Dissim& dissim = var_cast (subgraph. tree). dissims [dissimNum];
+  subPathTree. lca = nullptr;
   if (! subgraph. viaRoot (subPath))
   {
-    const Steiner* lca = static_cast <const DTNode*> (lca_) -> asSteiner ();
-    ASSERT (lca);
-    dissim. lca = lca;
+    subPathTree. lca = static_cast <const DTNode*> (lca_) -> asSteiner ();
+    ASSERT (subPathTree. lca);
   }
   for (const Tree::TreeNode* node : path)
   {
@@ -2176,7 +2304,21 @@ void subPath2tree_dissim (Subgraph &subgraph,
     #endif
     }
   }
-  dissim. prediction = subPath. dist_hat_tails + DistTree::path2prediction (path);
+  subPathTree. prediction = subPath. dist_hat_tails + DistTree::path2prediction (path);
+}
+
+
+
+void subPath2tree_dissim (Subgraph &subgraph,
+                          const SubPath &subPath,
+                          const Subgraph::SubPathTree &subPathTree,
+                          Real &absCriterion)
+// Update: absCriterion
+{
+  Dissim& dissim = var_cast (subgraph. tree). dissims [subPath. dissimNum];
+  if (subPathTree. lca)
+    dissim. lca = subPathTree. lca;
+  dissim. prediction = subPathTree. prediction;
   absCriterion += dissim. getAbsCriterion ();
 }
   
@@ -2191,8 +2333,13 @@ void subPath2tree_dissim_array (size_t from,
 {
   absCriterion = 0.0;
   Tree::LcaBuffer buf;
+  Subgraph::SubPathTree subPathTree;
   FOR_START (size_t, i, from, to)
-    subPath2tree_dissim (subgraph, subgraph. subPaths [i], buf, absCriterion, true);
+  {
+    const SubPath& subPath = subgraph. subPaths [i];
+    subPath2tree_path (subgraph, subPath, buf, subPathTree, true);
+    subPath2tree_dissim (subgraph, subPath, subPathTree, absCriterion);
+  }
 }
 #endif
 
@@ -2277,26 +2424,11 @@ void subPath2tree_subPathDissimsSet_array (size_t from,
 
 
 
-void Subgraph::subPaths2tree ()
+void Subgraph::deleteSubPaths ()
 {
-  ASSERT (dissimNums. empty ());
-
-  chron_subgraph2tree. start ();  
-
-
-  DistTree& tree_ = var_cast (tree);
-
-//const size_t dissims_big = 5 * 1024 * 1024;  // PAR  
-#ifdef MUTEX
-  const bool useThreads = (threads_max > 1 && Threads::empty () && subPaths. size () >= dissims_big);  // PAR 
-#endif
-  
   // Delete subPaths from tree
   if (true /*tree. dissims. size () < dissims_big*/)  // PAR  
   {
-  #ifdef MUTEX
-    ASSERT (! useThreads);
-  #endif
     // Time: const * p/8
     Vector<bool> subPathDissimsVec (tree. dissims. size (), false);
     // Time: O(|subPaths|)
@@ -2332,6 +2464,28 @@ void Subgraph::subPaths2tree ()
       arrayThreads (true, subPath2tree_subPathDissimsSet_array, area. size (), notypes, cref (area), cref (boundary), cref (subPathDissimsSet));
     }
   }
+}
+
+
+
+void Subgraph::subPaths2tree ()
+{
+  ASSERT (dissimNums. empty ());
+
+  chron_subgraph2tree. start ();  
+
+
+  DistTree& tree_ = var_cast (tree);
+
+//const size_t dissims_big = 5 * 1024 * 1024;  // PAR  
+#ifdef MUTEX
+  const bool useThreads = (threads_max > 1 && Threads::empty () && subPaths. size () >= dissims_big);  // PAR 
+#endif
+  
+#ifdef MUTEX
+  ASSERT (! useThreads);
+#endif
+  deleteSubPaths ();
   
   // Add subPaths in area to tree
   tree_. absCriterion -= subPathsAbsCriterion;
@@ -2349,8 +2503,12 @@ void Subgraph::subPaths2tree ()
 #endif
   {
     Tree::LcaBuffer buf;
+    SubPathTree subPathTree;
     for (const SubPath& subPath : subPaths)
-      subPath2tree_dissim (*this, subPath, buf, tree_. absCriterion /*, false*/);
+    {
+      subPath2tree_path (*this, subPath, buf, subPathTree /*, false*/);
+      subPath2tree_dissim (*this, subPath, subPathTree, tree_. absCriterion);
+    }
   }
   ASSERT (tree. absCriterion < inf);
   maximize (tree_. absCriterion, 0.0);
@@ -2363,6 +2521,36 @@ void Subgraph::subPaths2tree ()
 
 
 
+void Subgraph::subPaths2paths (Vector<SubPathTree> &subPathTrees)
+{
+  ASSERT (dissimNums. empty ());
+
+  deleteSubPaths ();
+
+  subPathTrees. resize (subPaths. size ());
+  Tree::LcaBuffer buf;
+  FFOR (size_t, i, subPaths. size ())
+    subPath2tree_path (*this, subPaths [i], buf, subPathTrees [i] /*, false*/);
+}
+
+
+
+void Subgraph::paths2tree (const Vector<SubPathTree> &subPathTrees)
+{
+  ASSERT (subPathTrees. size () == subPaths. size ());
+
+  DistTree& tree_ = var_cast (tree);
+
+  tree_. absCriterion -= subPathsAbsCriterion;
+  ASSERT (tree. absCriterion < inf);
+  FFOR (size_t, i, subPaths. size ())
+    subPath2tree_dissim (*this, subPaths [i], subPathTrees [i], tree_. absCriterion);
+  ASSERT (tree. absCriterion < inf);
+  maximize (tree_. absCriterion, 0.0);
+}
+
+
+
 void Subgraph::node2dissimNums (const DTNode* node)
 { 
   ASSERT (node);
@@ -2860,8 +3048,8 @@ Image::~Image ()
 
 
 
-void Image::processSmall (const DTNode* center_arg,
-                          uint areaRadius)
+void Image::copySmall (const DTNode* center_arg,
+                       uint areaRadius_arg)
 { 
   ASSERT (subgraph. empty ());
   ASSERT (! tree);              
@@ -2873,6 +3061,7 @@ void Image::processSmall (const DTNode* center_arg,
   ASSERT (center->graph);
   ASSERT (! center->inDiscernible ());
 
+  areaRadius = areaRadius_arg;
   ASSERT (areaRadius >= 1);
 //ASSERT (areaRadius <= areaRadius_std);    
 
@@ -2929,9 +3118,15 @@ void Image::processSmall (const DTNode* center_arg,
     cerr << "  " << areaRadius 
          << ' ' << boundary. size () 
          << ' ' << area. size () - boundary. size ();
-  
+}
+
+
+
+void Image::optimizeSmall ()
+{
+  ASSERT (tree);
+  ASSERT (areaRadius >= 1);
 
-  // Optimization
   chron_subgraphOptimize. start ();
   const size_t leaves = tree->name2leaf. size ();
   ASSERT (leaves >= 2);
@@ -2975,7 +3170,7 @@ void Image::processSmall (const DTNode* center_arg,
 
 void Image::processLarge (const Steiner* subTreeRoot,
                           const VectorPtr<Tree::TreeNode> &possibleBoundary,
-                          const VectorOwn<Change>* changes)
+                          const VectorPtr<Change>* changes)
 {
   ASSERT (subgraph. empty ());
   ASSERT (! tree);              
@@ -3076,6 +3271,18 @@ void Image::processLarge (const Steiner* subTreeRoot,
 
 
 bool Image::apply ()
+{
+  if (! applyTopology ())
+    return false;
+  // Topology, absCriterion
+  subgraph. subPaths2tree ();
+  applyFinish ();
+  return true;
+}
+
+
+
+bool Image::applyTopology ()
 {
   if (! tree)
     return false;
@@ -3084,7 +3291,7 @@ bool Image::apply ()
   
   
   DistTree& wholeTree = var_cast (subgraph. tree);
-  const bool unstableCutP = ! wholeTree. unstableCut. empty ();
+  unstableCutP = ! wholeTree. unstableCut. empty ();
   
 
   DiGraph::Node2Node boundary2new (DiGraph::reverse (new2old));
@@ -3202,10 +3409,18 @@ bool Image::apply ()
     wholeTree. root = root_old;
   }
   ASSERT (wholeTree. root);
+  
+  return true;
+}
    
-  // Topology, absCriterion
-  subgraph. subPaths2tree ();
-    
+  
+  
+void Image::applyFinish ()
+{
+  ASSERT (tree);
+  
+  DistTree& wholeTree = var_cast (subgraph. tree);
+  
   // deleteLenZero
   for (const auto& it : new2old)
   {
@@ -3217,7 +3432,7 @@ bool Image::apply ()
   wholeTree. toDelete. deleteData ();
 
 
-  if (center && contains (boundary2new, center))
+  if (center && subgraph. boundary. containsFast (center))
   {
     ASSERT (center->graph == & wholeTree);
     if (unstableCutP)
@@ -3248,9 +3463,6 @@ bool Image::apply ()
 
   if (verbose (1))
     wholeTree. reportErrors (cout);
-
-    
-  return true;
 }
 
 
@@ -3384,6 +3596,23 @@ void processDissimLine (size_t from,
 
 
 
+void dissimNums2shared (Vector<uint> &dissimNums)
+// Input: dissimNums: Subgraph::subPaths2dissimNums() of Image's processed at the same time and then apply()'ed
+// Output: dissimNums: occurring more than once, i.e., with inexact Dissim::prediction; sort()'ed, uniq()'ed
+// Time: O(|dissimNums| log(|dissimNums|))
+{
+  dissimNums. sort ();
+  size_t n = 0;
+  FFOR_START (size_t, i, 1, dissimNums. size ())
+    if (   dissimNums [i] == dissimNums [i - 1]
+        && (! n || dissimNums [n - 1] != dissimNums [i])
+       )
+      dissimNums [n++] = dissimNums [i];
+  dissimNums. resize (n);
+}
+
+
+
 struct OptimizeSmallSubgraph
 {
   Image image;
@@ -3417,42 +3646,232 @@ struct OptimizeSmallSubgraph
 
 
 
-void processOptimizeSmallSubgraph (OptimizeSmallSubgraph &oss)
+struct OptimizeSmallSubgraphScheduler
+// Rolling scheduling of OptimizeSmallSubgraph's of new leaves by threads
+// A thread which is free starts the first new leaf whose OptimizeSmallSubgraph is not close() to a running one
+// Image::copySmall() reads the tree and Image::apply() changes it => the copies are done under treeMtx shared, apply() under treeMtx exclusive;
+//   Image::optimizeSmall() does not need treeMtx
+// Image's are apply()'ed in the order of their start by the thread which finished the first running OptimizeSmallSubgraph
 {
-  oss. process ();
-}
-
-
-}
+private:
+  DistTree &tree;
+  VectorPtr<Leaf> &newLeaves;
+  const uint radius;
+  Progress &prog;
 
+  struct Job
+  {
+    unique_ptr<OptimizeSmallSubgraph> oss;
+    bool processed {false};
+    size_t applied_start {0};
+      // appliedNum at the start <= appliedNum at Image::copySmall()
+    Vector<uint> dissimNums;
+      // Subgraph::subPaths2dissimNums(), sort()'ed
+  };
+  list<Job> running;
+    // Started and not apply()'ed
+    // In the order of start
+  size_t leafStart {0};
+    // newLeaves[i] = nullptr for i < leafStart
+  list<Job> applied;
+    // apply()'ed and possibly running at the same time with a Job in running
+  size_t appliedNum {0};
+    // apply()'ed Job's
+  size_t reported {0};
+    // Job's reported by prog
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::shared_mutex treeMtx;
+public:
+  Vector<uint> inexactDissimNums;
+    // Dissim::prediction's changed by Image's which were processed at the same time
+  // Statistics
+  size_t waits {0};
+    // # times a free thread found no new leaf which could be started
+  double busy {0.0};
+    // Sum of processing times of all threads, seconds
+  double capacity {0.0};
+    // Wall time * # threads, seconds
+
+
+  OptimizeSmallSubgraphScheduler (DistTree &tree_arg,
+                                  VectorPtr<Leaf> &newLeaves_arg,
+                                  uint radius_arg,
+                                  Progress &prog_arg)
+    : tree (tree_arg)
+    , newLeaves (newLeaves_arg)
+    , radius (radius_arg)
+    , prog (prog_arg)
+    {}
 
 
-DistTree::DistTree (const DissimParam &dissimParam_arg,
-	                  const string &dataDirName,
-	                  const string &treeFName,
-                    bool loadNewLeaves,
-                    bool loadDissim,
-                    bool optimizeP)
-: dissimParam (dissimParam_arg)
-, rand (seed_global)
-{
-  ASSERT (! dataDirName. empty ());
-  ASSERT (dataDirName. back () == '/');
-  IMPLY (optimizeP, loadDissim);
-  
-  
-  // Initial tree topology
-  loadTreeFile (nvl (treeFName, dataDirName + "tree"));  
-  ASSERT (root);
-  ASSERT (nodes. front () == root);
-  ASSERT (static_cast <const DTNode*> (root) -> asSteiner ());
-  
-  setName2leaf ();  
-  
-  
-  VectorPtr<Leaf> newLeaves;  newLeaves. reserve (name2leaf. size () / 10 + 1);  // PAR
-  if (loadNewLeaves)
-  {
+  void process ()
+    { const auto start = chrono::steady_clock::now ();
+      {
+        Unverbose unv;
+        Threads th (threads_max - 1);
+        FOR (size_t, i, threads_max - 1)
+          th << thread (& OptimizeSmallSubgraphScheduler::processThread, this);
+        processThread ();
+      }
+      capacity = chrono::duration<double> (chrono::steady_clock::now () - start). count () * (double) threads_max;
+      ASSERT (running. empty ());
+      ASSERT (appliedNum == reported);
+      inexactDissimNums. sort ();
+      inexactDissimNums. uniq ();
+    }
+  void report (ostream &os) const
+    { os << "Jobs: " << appliedNum << "  waits: " << waits;
+      if (capacity > 0.0)
+        os << "  thread utilization: " << real2str (busy / capacity * 100.0, 1, false) << '%';
+      os << endl;
+    }
+private:
+  void processThread ()
+    { Job* job = nullptr;
+      double jobBusy = 0.0;
+      for (;;)
+      {
+        {
+          std::unique_lock<std::mutex> lock (mtx);
+          if (job)
+          {
+            job->processed = true;
+            busy += jobBusy;
+            job = nullptr;
+          }
+          for (;;)
+          {
+            if (applyProcessed ())
+              cv. notify_all ();
+            if (isMainThread ())
+              while (reported < appliedNum)
+              {
+                prog (tree. absCriterion2str ());
+                reported++;
+              }
+            if ((job = startNext ()))
+              break;
+            if (running. empty ())
+            {
+              cv. notify_all ();
+              return;
+            }
+            waits++;
+            cv. wait (lock);
+          }
+        }
+        const auto start = chrono::steady_clock::now ();
+        {
+          const std::shared_lock<std::shared_mutex> treeLock (treeMtx);
+          job->oss->image. copySmall (job->oss->center, job->oss->radius);
+        }
+        job->oss->image. optimizeSmall ();
+        jobBusy = chrono::duration<double> (chrono::steady_clock::now () - start). count ();
+      }
+    }
+    // Requires: !Threads::empty() or threads_max = 1
+  Job* startNext ()
+    // Requires: mtx is locked
+    { while (leafStart < newLeaves. size () && ! newLeaves [leafStart])
+        leafStart++;
+      FOR_START (size_t, i, leafStart, newLeaves. size ())
+        if (const Leaf* leaf = newLeaves [i])
+        {
+          unique_ptr<OptimizeSmallSubgraph> oss (new OptimizeSmallSubgraph (tree, leaf->getDiscernible (), radius));
+          bool close = false;
+          for (const Job& job : running)
+            if (oss->close (* job. oss))
+            {
+              close = true;
+              break;
+            }
+          if (close)
+            continue;
+          newLeaves [i] = nullptr;
+          running. push_back (Job ());
+          running. back (). oss = std::move (oss);
+          running. back (). applied_start = appliedNum;
+          return & running. back ();
+        }
+      return nullptr;
+    }
+    // Return: nullptr <=> no new leaf can be started
+  bool applyProcessed ()
+    // Requires: mtx is locked
+    // Return: true <=> some Job's are apply()'ed
+    { bool changed = false;
+      while (! running. empty () && running. front (). processed)
+      {
+        applied. splice (applied. end (), running, running. begin ());
+        Job& job = applied. back ();
+        {
+          const std::unique_lock<std::shared_mutex> treeLock (treeMtx);
+          EXEC_ASSERT (job. oss->apply ());
+          appliedNum++;
+        }
+        job. oss->image. subgraph. subPaths2dissimNums (job. dissimNums);
+        job. dissimNums. sort ();
+        // The Job's apply()'ed after the start of job may have changed the copied Dissim's of job
+        size_t appliedIndex = appliedNum - applied. size ();
+        for (const Job& other : applied)
+        {
+          if (& other == & job)
+            break;
+          if (appliedIndex >= job. applied_start)
+          {
+            Vector<uint> shared (other. dissimNums);
+            shared << job. dissimNums;
+            dissimNums2shared (shared);
+            inexactDissimNums << std::move (shared);
+          }
+          appliedIndex++;
+        }
+        // Image is not needed any more
+        job. oss. reset ();
+        changed = true;
+      }
+      // applied: only Job's which may be running at the same time with a Job in running
+      size_t applied_start_min = appliedNum;
+      for (const Job& job : running)
+        minimize (applied_start_min, job. applied_start);
+      while (applied. size () > appliedNum - applied_start_min)
+        applied. pop_front ();
+      return changed;
+    }
+};
+
+
+}
+
+
+
+DistTree::DistTree (const DissimParam &dissimParam_arg,
+	                  const string &dataDirName,
+	                  const string &treeFName,
+                    bool loadNewLeaves,
+                    bool loadDissim,
+                    bool optimizeP)
+: dissimParam (dissimParam_arg)
+, rand (seed_global)
+{
+  ASSERT (! dataDirName. empty ());
+  ASSERT (dataDirName. back () == '/');
+  IMPLY (optimizeP, loadDissim);
+  
+  
+  // Initial tree topology
+  loadTreeFile (nvl (treeFName, getBinOrTextFName (dataDirName + "tree")));  
+  ASSERT (root);
+  ASSERT (nodes. front () == root);
+  ASSERT (static_cast <const DTNode*> (root) -> asSteiner ());
+  
+  setName2leaf ();  
+  
+  
+  VectorPtr<Leaf> newLeaves;  newLeaves. reserve (name2leaf. size () / 10 + 1);  // PAR
+  if (loadNewLeaves)
+  {
     section ("Loading new leaves", true);
     LineInput f (dataDirName + "leaf", 1);  // PAR
     string leafName, anchorName;
@@ -3514,9 +3933,12 @@ DistTree::DistTree (const DissimParam &dissimParam_arg,
   if (loadDissim)
   {
     loadDissimPrepare (name2leaf. size () * getSparseDissims_size ()); 
-    const string fName (dataDirName + "dissim");
+    const string fName (getBinOrTextFName (dataDirName + "dissim"));
+    if (DissimBin::isDissimBin (fName))
+      loadDissimBin (fName);
+    else
     {
-      const Vector<DissimLine> dissimLines (getDissimLines (fName, dissims. capacity (), false));
+      const Vector<DissimLine> dissimLines (getDissimLines (fName, false));
       {
         Progress prog (dissimLines. size (), dissim_progress);
         for (const DissimLine &dl : dissimLines)
@@ -3570,46 +3992,16 @@ DistTree::DistTree (const DissimParam &dissimParam_arg,
       constexpr uint radius = 2 * areaRadius_std;  // PAR
       if (threads_max > 1)
       {
+        Vector<uint> inexactDissimNums;
         {
           Progress prog (newLeaves. size ());
-          while (! newLeaves. empty ())
-          {
-            VectorOwn<OptimizeSmallSubgraph> osss;  osss. reserve (newLeaves. size ());
-            FFOR (size_t, i, newLeaves. size ())
-            {
-              if (osss. size () >= threads_max)
-                break;
-              auto oss = new OptimizeSmallSubgraph (*this, newLeaves [i] -> getDiscernible (), radius);  
-              for (const OptimizeSmallSubgraph* oss1 : osss)
-                if (oss->close (*oss1))
-                {
-                  delete oss;
-                  oss = nullptr;
-                  break;
-                }
-              if (! oss)
-                continue;
-              osss << oss;
-              newLeaves [i] = nullptr;
-            }
-            ASSERT (! osss. empty ());
-            {
-              Unverbose unv;
-              Threads th (osss. size () - 1);
-              FFOR_START (size_t, i, 1, osss. size ())            
-                th << thread (processOptimizeSmallSubgraph, ref (* var_cast (osss [i])));
-              var_cast (osss [0]) -> process ();
-            }
-            newLeaves. filterValue ([] (const Leaf* leaf) { return ! leaf; });
-            // Use Threads for apply() for sibling subtrees ??
-            for (const OptimizeSmallSubgraph* oss : osss)
-            {
-              EXEC_ASSERT (var_cast (oss) -> apply ());
-              prog (absCriterion2str ());
-            }
-          }
+          OptimizeSmallSubgraphScheduler scheduler (*this, newLeaves, radius, prog);
+          scheduler. process ();
+          scheduler. report (cerr);
+          inexactDissimNums = std::move (scheduler. inexactDissimNums);
         }
-        setPredictionAbsCriterion ();
+        newLeaves. clear ();
+        setPredictionAbsCriterion (inexactDissimNums);
         reportErrors (cerr);
       }
       else
@@ -4230,6 +4622,12 @@ void DistTree::loadTreeFile (const string &fName)
 {
   ASSERT (! subDepth);
   ASSERT (! fName. empty ());
+  
+  if (isBinFile (fName))
+  {
+    loadTreeBin (fName);
+    return;
+  }
 
   const StringVector lines (fName, (size_t) 10000, false);  // PAR
   QC_ASSERT (! lines. empty ());
@@ -4381,6 +4779,597 @@ bool DistTree::loadLines (const StringVector &lines,
 
 
 
+namespace
+{
+  
+// Binary tree file, see DistTree::saveBinFile()
+//   <BinTreeHeader> <BinTreeNode>* <BinTreeDeformation>* <string pool>
+// BinTreeNode's are in the depth-first order: BinTreeNode::parent < own index
+
+constexpr uint32_t binTree_version = 1;
+constexpr uint32_t binTree_none = numeric_limits<uint32_t>::max ();
+const string binTree_magic ("DistTree.bin");
+
+
+struct BinTreeHeader
+{
+  char magic [16];
+  uint32_t version {binTree_version};
+  uint32_t reserved {0};
+  uint64_t nodes {0};
+  uint64_t deformations {0};
+  uint64_t poolSize {0};
+};
+
+
+struct BinTreeNode
+{
+  uint32_t parent {binTree_none};
+    // Index of BinTreeNode
+  uint32_t name {binTree_none};
+    // Offset in the string pool
+  double len {NaN};
+  double errorDensity {NaN};
+  double normCriterion {NaN};
+  uint8_t leaf {0};
+  uint8_t discernible {1};
+  uint8_t reserved [6] {0, 0, 0, 0, 0, 0};
+};
+
+
+struct BinTreeDeformation
+// DistTree::DeformationPair
+{
+  uint32_t node {binTree_none};
+  uint32_t leafName1 {binTree_none};
+  uint32_t leafName2 {binTree_none};
+  uint32_t reserved {0};
+  double deformation {NaN};
+};
+
+
+static_assert (sizeof (BinTreeHeader)      == 48);
+static_assert (sizeof (BinTreeNode)        == 40);
+static_assert (sizeof (BinTreeDeformation) == 24);
+
+
+
+// Checkpoint file, see DistTree::saveCheckpoint()
+//   <CheckpointHeader> <binary tree> <DTNode::stable: uint8_t>* <DissimType::scaleCoeff: double>* <CheckpointDissim>* 
+//   (<pathDissimNums size: uint64_t> <dissimNum: uint32_t>*)* 
+// Nodes are in the order of the binary tree, Steiner's only for pathDissimNums
+
+constexpr uint32_t checkpoint_version = 2;
+const string checkpoint_magic ("DistTree.ckpt");
+
+
+struct CheckpointHeader
+{
+  char magic [16];
+  uint32_t version {checkpoint_version};
+  uint32_t stage {0};
+  uint32_t iter {0};
+  uint32_t flags {0};
+  uint8_t multFixed {0};
+  uint8_t reserved [7] {0, 0, 0, 0, 0, 0, 0};
+  uint64_t dissims {0};
+  uint64_t dissimTypes {0};
+  // Parameters which must be the same when resuming
+  uint32_t varianceType {0};
+  uint32_t reserved1 {0};
+  double variancePower {NaN};
+  double variance_min {NaN};
+  double dissimPower {NaN};
+  double dissimCoeff {NaN};
+  double hybridness_min {NaN};
+  double boundary {NaN};
+};
+
+
+struct CheckpointDissim
+{
+  uint32_t leaf1 {binTree_none};
+  uint32_t leaf2 {binTree_none};
+  uint32_t lca {binTree_none};
+    // Indices of nodes
+  uint32_t reserved {0};
+  double target {NaN};
+  double prediction {NaN};
+  double mult {NaN};
+};
+
+
+static_assert (sizeof (CheckpointHeader) == 112);
+static_assert (sizeof (CheckpointDissim) == 40);
+
+
+
+struct BinTreePool
+{
+  string pool;
+  
+  uint32_t add (const string &s)
+    { ASSERT (! contains (s, '\0'));
+      const size_t offset = pool. size ();
+      if (offset + s. size () >= (size_t) binTree_none)
+        throw runtime_error (FUNC "Too many names for a binary tree file");
+      pool += s;
+      pool += '\0';
+      return (uint32_t) offset;
+    }
+};
+
+}
+
+
+
+const string DistTree::binSuff (".bin");
+
+
+
+void DistTree::loadTreeBin (const string &fName)
+{
+#ifndef _MSC_VER
+  const MappedFile mf (fName, true);
+  size_t pos = 0;
+  Vector<DTNode*> index2node;
+  loadTreeBin (mf, pos, index2node);
+  if (pos != mf. size)
+    throw runtime_error (FUNC + strQuote (fName) + " is damaged");
+#else
+  NOT_IMPLEMENTED;
+#endif
+}
+
+
+
+#ifndef _MSC_VER
+void DistTree::loadTreeBin (const MappedFile &mf,
+                            size_t &pos,
+                            Vector<DTNode*> &index2node)
+{
+  ASSERT (! subDepth);
+  ASSERT (nodes. empty ());
+  ASSERT (index2node. empty ());
+  
+  const string& fName = mf. fName;
+  BinTreeHeader header;
+  mf. readBin (pos, header);
+  if (strncmp (header. magic, binTree_magic. c_str (), sizeof (header. magic)))
+    throw runtime_error (FUNC + strQuote (fName) + " is not a binary tree file");
+  if (header. version != binTree_version)
+    throw runtime_error (FUNC + strQuote (fName) + ": unsupported binary tree file version " + to_string (header. version));
+  QC_ASSERT (header. nodes);
+  QC_ASSERT (header. nodes < binTree_none);
+    
+  const size_t poolStart = pos 
+                           + header. nodes        * sizeof (BinTreeNode) 
+                           + header. deformations * sizeof (BinTreeDeformation);
+  if (poolStart + header. poolSize > mf. size)
+    throw runtime_error (FUNC + strQuote (fName) + " is damaged");
+  const char* pool = mf. data + poolStart;
+  const auto getName = [&] (uint32_t offset) 
+    { if (offset >= header. poolSize)
+        throw runtime_error (FUNC + strQuote (fName) + ": bad name offset");
+      return string (pool + offset); 
+    };
+  if (header. poolSize && pool [header. poolSize - 1])
+    throw runtime_error (FUNC + strQuote (fName) + ": string pool is not terminated");
+    
+  index2node. reserve (header. nodes);
+  {
+    Progress prog (header. nodes, 100000);  // PAR
+    FFOR (size_t, i, header. nodes)
+    {
+      prog ();
+      BinTreeNode rec;
+      mf. readBin (pos, rec);
+      Steiner* parent = nullptr;
+      if (rec. parent != binTree_none)
+      {
+        QC_ASSERT (rec. parent < i);
+        parent = var_cast (index2node [rec. parent] -> asSteiner ());
+        QC_ASSERT (parent);
+      }
+      else
+        QC_ASSERT (! i);
+      if (parent || ! isNan (rec. len))
+        QC_ASSERT (rec. len >= 0.0);
+      DTNode* dtNode = nullptr;
+      if (rec. leaf)
+      {
+        QC_ASSERT (parent);
+        auto leaf = new Leaf (*this, parent, rec. len, getName (rec. name));
+        leaf->discernible = rec. discernible;
+        leaf->normCriterion = rec. normCriterion;
+        dtNode = leaf;
+      }
+      else
+      {
+        auto steiner = new Steiner (*this, parent, rec. len);
+        if (rec. name != binTree_none)
+          steiner->name = getName (rec. name);
+        dtNode = steiner;
+      }
+      ASSERT (dtNode);
+      dtNode->errorDensity = rec. errorDensity;
+      index2node << dtNode;
+    }
+  }
+  
+  FOR (size_t, i, header. deformations)
+  {
+    BinTreeDeformation rec;
+    mf. readBin (pos, rec);
+    QC_ASSERT (rec. node < index2node. size ());
+    QC_ASSERT (rec. deformation >= 0.0);
+    node2deformationPair [index2node [rec. node]] = std::move (DeformationPair {getName (rec. leafName1), getName (rec. leafName2), rec. deformation});
+  }
+  ASSERT (pos == poolStart);
+  pos += header. poolSize;
+}
+#endif
+
+
+
+void DistTree::saveBinFile (const string &fName) const
+{
+  if (fName. empty ())
+    return;
+  
+  ofstream f (fName, ios_base::binary | ios_base::out);
+  if (! f. good ())
+    throw runtime_error (FUNC "Cannot create file " + shellQuote (fName));
+  VectorPtr<DTNode> index2node;
+  saveBin (f, index2node);
+  f. close ();
+  if (! f. good ())
+    throw runtime_error (FUNC "Cannot write file " + shellQuote (fName));
+}
+
+
+
+void DistTree::saveBin (ostream &os,
+                        VectorPtr<DTNode> &index2node) const
+{
+  ASSERT (root);
+  ASSERT (index2node. empty ());
+  
+  index2node. reserve (nodes. size ());
+  Vector<BinTreeNode> recs;  recs. reserve (nodes. size ());
+  Vector<BinTreeDeformation> deformations;
+  BinTreePool pool;  pool. pool. reserve (name2leaf. size () * 16);  // PAR
+  {
+    // Depth-first order
+    Vector<pair<const DTNode*, uint32_t/*parent index*/>> stack;  stack. reserve (nodes. size ());
+    stack << pair<const DTNode*, uint32_t> (static_cast <const DTNode*> (root), binTree_none);
+    while (! stack. empty ())
+    {
+      const pair<const DTNode*, uint32_t> p (stack. back ());
+      stack. pop_back ();
+      const DTNode* dtNode = p. first;
+      ASSERT (dtNode);
+      if (recs. size () >= (size_t) binTree_none)
+        throw runtime_error (FUNC "Too many nodes for a binary tree file");
+      const uint32_t index = (uint32_t) recs. size ();
+      index2node << dtNode;
+      
+      BinTreeNode rec;
+      rec. parent = p. second;
+      rec. len = dtNode->len;
+      rec. errorDensity = dtNode->errorDensity;
+      if (const Leaf* leaf = dtNode->asLeaf ())
+      {
+        rec. leaf = 1;
+        rec. discernible = leaf->discernible;
+        rec. normCriterion = leaf->normCriterion;
+        rec. name = pool. add (leaf->name);
+      }
+      else if (! dtNode->name. empty ())
+        rec. name = pool. add (dtNode->name);
+      recs << rec;
+      
+      // As in DTNode::saveContent()
+      if (dtNode->maxDeformationDissimNum != dissims_max)
+      {
+        const Dissim& dissim = dissims [dtNode->maxDeformationDissimNum];
+        BinTreeDeformation def;
+        def. node = index;
+        def. leafName1 = pool. add (dissim. leaf1->name);
+        def. leafName2 = pool. add (dissim. leaf2->name);
+        def. deformation = dissim. getDeformation ();
+        deformations << def;
+      }
+      else if (const DeformationPair* dp = findPtr (node2deformationPair, dtNode))
+      {
+        BinTreeDeformation def;
+        def. node = index;
+        def. leafName1 = pool. add (dp->leafName1);
+        def. leafName2 = pool. add (dp->leafName2);
+        def. deformation = dp->deformation;
+        deformations << def;
+      }
+
+      const size_t start = stack. size ();
+      for (const DiGraph::Arc* arc : dtNode->arcs [false])
+        stack << pair<const DTNode*, uint32_t> (static_cast <const DTNode*> (arc->node [false]), index);
+      std::reverse (stack. begin () + (long) start, stack. end ());
+    }
+  }
+  
+  BinTreeHeader header;
+  memset (header. magic, 0, sizeof (header. magic));
+  memcpy (header. magic, binTree_magic. c_str (), binTree_magic. size ());
+  header. nodes        = recs. size ();
+  header. deformations = deformations. size ();
+  header. poolSize     = pool. pool. size ();
+  
+  writeBin (os, header);
+  os. write (reinterpret_cast <const char*> (recs. data ()),         (streamsize) (recs. size ()         * sizeof (BinTreeNode)));
+  os. write (reinterpret_cast <const char*> (deformations. data ()), (streamsize) (deformations. size () * sizeof (BinTreeDeformation)));
+  os. write (pool. pool. data (), (streamsize) pool. pool. size ());
+}
+
+
+
+void DistTree::saveCheckpoint (const string &fName,
+                               const Checkpoint &checkpoint) const
+{
+  if (fName. empty ())
+    return;
+  ASSERT (optimizable ());
+  ASSERT (! subDepth);
+  
+  const string tmpFName (fName + ".tmp");
+  {
+    ofstream f (tmpFName, ios_base::binary | ios_base::out);
+    if (! f. good ())
+      throw runtime_error (FUNC "Cannot create file " + shellQuote (tmpFName));
+      
+    CheckpointHeader header;
+    memset (header. magic, 0, sizeof (header. magic));
+    memcpy (header. magic, checkpoint_magic. c_str (), checkpoint_magic. size ());
+    header. stage       = checkpoint. stage;
+    header. iter        = checkpoint. iter;
+    header. flags       = checkpoint. flags;
+    header. multFixed   = multFixed;
+    header. dissims     = dissims. size ();
+    header. dissimTypes = dissimTypes. size ();
+    header. varianceType   = (uint32_t) varianceType;
+    header. variancePower  = variancePower;
+    header. variance_min   = variance_min;
+    header. dissimPower    = dissimParam. power;
+    header. dissimCoeff    = dissimParam. coeff;
+    header. hybridness_min = dissimParam. hybridness_min;
+    header. boundary       = dissimParam. boundary;
+    writeBin (f, header);
+    
+    VectorPtr<DTNode> index2node;
+    saveBin (f, index2node);
+    ASSERT (index2node. size () == nodes. size ());
+    unordered_map<const DTNode*, uint32_t> node2index;  node2index. rehash (index2node. size ());
+    FFOR (size_t, i, index2node. size ())
+      node2index [index2node [i]] = (uint32_t) i;
+    const auto getIndex = [&node2index] (const DTNode* dtNode) 
+      { if (! dtNode)
+          return binTree_none;
+        const uint32_t* index = findPtr (node2index, dtNode);
+        ASSERT (index);
+        return *index;
+      };
+    
+    for (const DTNode* dtNode : index2node)
+      writeBin (f, (uint8_t) dtNode->stable);
+    for (const DissimType& dt : dissimTypes)
+      writeBin (f, (double) dt. scaleCoeff);
+      
+    {
+      Vector<CheckpointDissim> recs;  recs. reserve (dissimBlock_size);
+      const auto flush = [&recs, &f] ()
+        { f. write (reinterpret_cast <const char*> (recs. data ()), (streamsize) (recs. size () * sizeof (CheckpointDissim)));
+          recs. clear ();
+        };
+      for (const Dissim& dissim : dissims)
+      {
+        CheckpointDissim rec;
+        rec. leaf1      = getIndex (dissim. leaf1);
+        rec. leaf2      = getIndex (dissim. leaf2);
+        rec. lca        = getIndex (dissim. lca);
+        rec. target     = dissim. target;
+        rec. prediction = dissim. prediction;
+        rec. mult       = dissim. mult;
+        recs << rec;
+        if (recs. size () == dissimBlock_size)
+          flush ();
+      }
+      flush ();
+    }
+    
+    Vector<uint> dissimNums;
+    for (const DTNode* dtNode : index2node)
+      if (dtNode->asSteiner ())
+      {
+        dissimNums. clear ();
+        for (const uint dissimNum : dtNode->pathDissimNums)
+          dissimNums << dissimNum;
+        writeBin<uint64_t> (f, dissimNums. size ());
+        f. write (reinterpret_cast <const char*> (dissimNums. data ()), (streamsize) (dissimNums. size () * sizeof (uint32_t)));
+      }
+    
+    f. close ();
+    if (! f. good ())
+      throw runtime_error (FUNC "Cannot write file " + shellQuote (tmpFName));
+  }
+  std::filesystem::rename (tmpFName, fName);
+}
+
+
+
+DistTree::DistTree (const DissimParam &dissimParam_arg,
+	                  const string &checkpointFName,
+                    const string &dissimFName,
+                    const string &dissimAttrName,
+	                  const string &multAttrName,
+	                  Checkpoint &checkpoint)
+: dissimParam (dissimParam_arg)
+, rand (seed_global)
+{
+  ASSERT (! dissimFName. empty ());
+  
+#ifndef _MSC_VER
+  const MappedFile mf (checkpointFName, true);
+  size_t pos = 0;
+
+  CheckpointHeader header;
+  mf. readBin (pos, header);
+  if (strncmp (header. magic, checkpoint_magic. c_str (), sizeof (header. magic)))
+    throw runtime_error (FUNC + strQuote (checkpointFName) + " is not a checkpoint file");
+  if (header. version != checkpoint_version)
+    throw runtime_error (FUNC + strQuote (checkpointFName) + ": unsupported checkpoint file version " + to_string (header. version));
+  {
+    const auto paramMismatch = [&checkpointFName] (const string &what)
+      { throw runtime_error (FUNC + strQuote (checkpointFName) + " was saved with a different " + what); };
+    const auto eq = [] (double a, double b)
+      { return a == b || (isNan (a) && isNan (b)); };
+    if (header. varianceType != (uint32_t) varianceType)
+      paramMismatch ("variance function");
+    if (! eq (header. variancePower, variancePower))
+      paramMismatch ("variance power");
+    if (! eq (header. variance_min, variance_min))
+      paramMismatch ("min. variance");
+    if (   ! eq (header. dissimPower, dissimParam. power)
+        || ! eq (header. dissimCoeff, dissimParam. coeff)
+       )
+      paramMismatch ("dissimilarity transformation");
+    if (   ! eq (header. hybridness_min, dissimParam. hybridness_min)
+        || ! eq (header. boundary,       dissimParam. boundary)
+       )
+      paramMismatch ("dissimilarity boundary or hybridness");
+  }
+  checkpoint. stage = header. stage;
+  checkpoint. iter  = header. iter;
+  checkpoint. flags = header. flags;
+
+  Vector<DTNode*> index2node;
+  loadTreeBin (mf, pos, index2node);
+  ASSERT (root);
+  ASSERT (static_cast <const DTNode*> (root) -> asSteiner ());
+  setName2leaf ();
+
+  loadDissimDs (dissimFName, dissimAttrName, multAttrName);
+  if (! getConnected ())
+    throw runtime_error (FUNC "Disconnected objects");
+  if (! setDiscernibles_ds ())
+    throw runtime_error (FUNC "No discernible objects");
+  dissimDs2dissims (false);  
+  
+  const auto mismatch = [&checkpointFName] (const string &what)
+    { throw runtime_error (FUNC + strQuote (checkpointFName) + " does not match the data: " + what); };
+  if (header. dissims != dissims. size ())
+    mismatch ("number of dissimilarities");
+  if (header. dissimTypes != dissimTypes. size ())
+    mismatch ("number of dissimilarity types");
+  const auto getNode = [&index2node, &mismatch] (uint32_t index) -> DTNode*
+    { if (index == binTree_none)
+        return nullptr;
+      if (index >= index2node. size ())
+        mismatch ("node index");
+      return index2node [index];
+    };
+    
+  for (DTNode* dtNode : index2node)
+  {
+    uint8_t stable = 0;
+    mf. readBin (pos, stable);
+    dtNode->stable = stable;
+  }
+  for (DissimType& dt : dissimTypes)
+  {
+    double scaleCoeff = NaN;
+    mf. readBin (pos, scaleCoeff);
+    dt. scaleCoeff = scaleCoeff;
+  }
+  multFixed = header. multFixed;
+  
+  for (Dissim& dissim : dissims)
+  {
+    CheckpointDissim rec;
+    mf. readBin (pos, rec);
+    if (   getNode (rec. leaf1) != dissim. leaf1
+        || getNode (rec. leaf2) != dissim. leaf2
+       )
+      mismatch ("objects of a dissimilarity");
+    const DTNode* lca = getNode (rec. lca);
+    if (lca && ! lca->asSteiner ())
+      mismatch ("LCA of a dissimilarity");
+    dissim. lca        = lca ? lca->asSteiner () : nullptr;
+    dissim. target     = rec. target;
+    dissim. prediction = rec. prediction;
+    dissim. mult       = rec. mult;
+  }
+  
+  for (DTNode* dtNode : index2node)
+    if (dtNode->asSteiner ())
+    {
+      uint64_t size = 0;
+      mf. readBin (pos, size);
+      if (size > dissims. size () || pos + size * sizeof (uint32_t) > mf. size)
+        throw runtime_error (FUNC + strQuote (checkpointFName) + " is damaged");
+      dtNode->pathDissimNums. clear ();
+      dtNode->pathDissimNums. reserve (size);
+      FOR (size_t, i, size)
+      {
+        uint32_t dissimNum = 0;
+        mf. readBin (pos, dissimNum);
+        if (dissimNum >= dissims. size ())
+          throw runtime_error (FUNC + strQuote (checkpointFName) + " is damaged");
+        dtNode->pathDissimNums << dissimNum;
+      }
+    }
+  if (pos != mf. size)
+    throw runtime_error (FUNC + strQuote (checkpointFName) + " is damaged");
+  
+  packPathDissimNums ();
+  
+  const DissimSums sums (getDissimSums ());
+  mult_sum     = sums. mult_sum;
+  target2_sum  = sums. target2_sum;
+  absCriterion = sums. absCriterion;
+#else
+  NOT_IMPLEMENTED;
+#endif
+}
+
+
+
+bool DistTree::isBinFile (const string &fName)
+{
+  ifstream f (fName, ios_base::binary | ios_base::in);
+  if (! f. good ())
+    return false;
+  BinTreeHeader header;
+  readBin (f, header);
+  return    f. good ()
+         && ! strncmp (header. magic, binTree_magic. c_str (), sizeof (header. magic));
+}
+
+
+
+string DistTree::getBinOrTextFName (const string &textFName)
+{
+  ASSERT (! textFName. empty ());
+  const string binFName (textFName + binSuff);
+  if (! fileExists (binFName))
+    return textFName;
+  if (   fileExists (textFName)
+      && std::filesystem::last_write_time (binFName) < std::filesystem::last_write_time (textFName)
+     )
+    return textFName;
+  return binFName;
+}
+
+
+
 void DistTree::setName2leaf ()
 {
   name2leaf. clear ();
@@ -4402,7 +5391,7 @@ void checkPositiveAttr2 (PositiveAttr2& attr)
   {
     Real maxCorrection;
     size_t row_bad, col_bad;
-    attr. matr. symmetrize (maxCorrection, row_bad, col_bad);
+    attr. symmetrize (maxCorrection, row_bad, col_bad);
     if (maxCorrection > 2.0 * pow (10.0, - (Real) attr. decimals))  // PAR
       cout << "maxCorrection = " << maxCorrection 
            << " at " << attr. ds. objs [row_bad] -> name 
@@ -4505,18 +5494,16 @@ void DistTree::mergeDissimAttrs ()
     ASSERT (dt. dissimAttr);
     Real s = 0.0;
     size_t n = 0; 
-    {
-      Real x = NaN;   
-      FFOR (size_t, i, dissimDs->objs. size ())
-        FFOR (size_t, j, dissimDs->objs. size ())
-          if (   dt. dissimAttr->matr. get (false, i, j, x)
-              && x < inf
-             )
-          {
-            s += x;
-            n++;
-          }
-    }
+    FFOR (size_t, i, dissimDs->objs. size ())
+      FFOR (size_t, j, dissimDs->objs. size ())
+      {
+        const Real x = dt. dissimAttr->get (i, j);
+        if (! isNan (x) && x < inf)
+        {
+          s += x;
+          n++;
+        }
+      }
     if (n == 0)
       throw runtime_error (FUNC "No data in dissimilarity " + strQuote (dt. dissimAttr->name));
     if (n == 1)
@@ -4541,12 +5528,11 @@ void DistTree::mergeDissimAttrs ()
     {
       Real dissim_sum = 0.0;
       Real mult_sum_  = 0.0;
-      Real x = NaN;
       ebool allZero = enull;
       for (const DissimType& dt : dissimTypes)
-        if (   dt. dissimAttr->matr. get (false, i, j, x) 
-            && x < inf
-           )
+      {
+        const Real x = dt. dissimAttr->get (i, j);
+        if (! isNan (x) && x < inf)
         {
           ASSERT (x >= 0.0);
           if (x)
@@ -4558,13 +5544,14 @@ void DistTree::mergeDissimAttrs ()
           dissim_sum += mult * x * dt. scaleCoeff;
           mult_sum_  += mult;
         }
+      }
       ASSERT (mult_sum_ >= 0.0);
       if (allZero == etrue)  
-        var_cast (dissimAttr) -> matr. put (false, i, j, 0.0);  // To collapse()
+        var_cast (dissimAttr) -> put (i, j, 0.0);  // To collapse()
       else if (mult_sum_)
       {
         ASSERT (dissim_sum >= 0.0);
-        var_cast (dissimAttr) -> matr. put (false, i, j, dissim_sum / mult_sum_);
+        var_cast (dissimAttr) -> put (i, j, dissim_sum / mult_sum_);
       }
     }
 }
@@ -5237,7 +6224,7 @@ void DistTree::neighborJoin ()
 
 
 
-void DistTree::dissimDs2dissims ()
+void DistTree::dissimDs2dissims (bool setPathsP)
 {
   ASSERT (dissimDs. get ());
   ASSERT (dissimAttr);
@@ -5303,7 +6290,8 @@ void DistTree::dissimDs2dissims ()
     dt. dissimAttr = nullptr;
 
 
-  setPaths (true);
+  if (setPathsP)
+    setPaths (true);
 }
 
 
@@ -5329,24 +6317,18 @@ void DistTree::loadDissimPrepare (size_t pairs_max)
 
 
 Vector<DissimLine> DistTree::getDissimLines (const string& fName,
-                                             size_t reserveSize,
                                              bool mayBeEmpty) const
 {
-  Vector<DissimLine> dissimLines;  dissimLines. reserve (reserveSize);
+  Vector<DissimLine> dissimLines;
   {
     {
       section ("Loading " + fName, true);
-      LineInput f (fName, dissim_progress);  
-      while (f. nextLine ())
-      {
-        DissimLine dl (f. line, f. lineNum);
-        if (DM_sp::finite (dl. dissim))
-        {
-          dissimLines << std::move (dl);
-          ASSERT (dl. name1. empty ());
-        }
-      }
-      if (! mayBeEmpty && ! f. lineNum)
+      const size_t lines = parseLines (fName, [] (string_view line, DissimLine &dl) 
+                                                { dl = DissimLine (line);
+                                                  return DM_sp::finite (dl. dissim);
+                                                }
+                                      , dissimLines, dissim_progress);
+      if (! mayBeEmpty && ! lines)
         throw runtime_error (FUNC "Empty " + fName);
     }
     section ("Sorting dissimilarities", true);
@@ -5358,6 +6340,64 @@ Vector<DissimLine> DistTree::getDissimLines (const string& fName,
   
   return dissimLines;
 }
+
+
+
+void DistTree::loadDissimBin (const string &fName)
+{
+  const DissimBin db (fName);
+  
+  Vector<Leaf*> id2leaf;  id2leaf. reserve (db. names. size ());
+  for (const string& name : db. names)
+    id2leaf << var_cast (findPtr (name2leaf, name));
+
+  section ("Loading " + fName, true);
+  size_t n = 0;
+  {
+    Progress prog (0, dissim_progress);
+    DissimBin::Merger merger (db);
+    DissimBin::Record rec;
+    while (merger. next (rec))
+    {
+      prog ();
+      n++;
+      Leaf* leaf1 = id2leaf [rec. id1];
+      Leaf* leaf2 = id2leaf [rec. id2];
+      // As in DissimLine::process()
+      if (leaf1)
+      {
+        leaf1->badCriterion = -1.0;  // temporary
+        if (leaf2)
+          leaf2->badCriterion = -1.0;  // temporary
+      }
+      addLoadedDissim (leaf1, leaf2, rec. dissim);
+    }
+  }
+  if (! n)
+    throw runtime_error (FUNC "Empty " + fName);
+}
+
+
+
+void DistTree::addLoadedDissim (Leaf* leaf1,
+                                Leaf* leaf2,
+                                Real dissim)
+{
+  ASSERT (! isNan (dissim));
+  ASSERT (dissim >= 0.0);
+  
+  if (! leaf1)
+    return;
+  if (! leaf2)
+    return;
+  if (   /*! DistTree_sp::variance_min 
+      &&*/ ! dissim 
+      && ! leaf1->getCollapsed (leaf2)  // Only for new Leaf's
+     )  
+    leaf1->collapse (leaf2);
+  if (! addDissim (leaf1, leaf2, dissim, 1.0/*temporary*/, no_index))
+    throw runtime_error (FUNC "Cannot add dissimilarity: " + leaf1->name + " " + leaf2->name + " " + toString (dissim));
+}
   
 
 
@@ -5574,12 +6614,43 @@ void DistTree::setPaths (bool setDissimMultP)
   }
 #endif
 
+  if (! subDepth)
+    packPathDissimNums ();
+
   if (setDissimMultP)
     setDissimMult (true);
 }
 
 
 
+namespace
+{
+
+void packPathDissimNums_array (size_t from,
+                               size_t to,
+                               Notype /*&res*/,
+                               const VectorPtr<DiGraph::Node> &nodeVec)
+{
+  FOR_START (size_t, i, from, to)
+    const_static_cast <DTNode*> (nodeVec [i]) -> pathDissimNums. pack ();
+}
+
+}
+
+
+
+void DistTree::packPathDissimNums ()
+{
+  VectorPtr<DiGraph::Node> nodeVec;  nodeVec. reserve (nodes. size ());
+  for (const DiGraph::Node* node : nodes)  
+    nodeVec << node;
+
+  vector<Notype> notypes;
+  arrayThreads (true, packPathDissimNums_array, nodeVec. size (), notypes, cref (nodeVec));
+}
+
+
+
 Json* DistTree::toJson (JsonContainer* parent_arg,
                         const string& name_arg) const
 {
@@ -5974,7 +7045,7 @@ void DistTree::qcPaths ()
     {
       prog ();
       DTNode* dtNode = static_cast <DTNode*> (node);
-      Vector<uint>& pathDissimNums = dtNode->pathDissimNums;
+      DissimNums& pathDissimNums = dtNode->pathDissimNums;
       pathDissimNums. sort ();
       QC_ASSERT (pathDissimNums. isUniq ());
       for (const uint dissimNum : pathDissimNums)
@@ -6019,15 +7090,17 @@ void DistTree::qcPaths ()
 
 void DistTree::setLca ()
 {
-  for (DiGraph::Node* node : nodes)
-  {
-    DTNode* dtNode = static_cast <DTNode*> (node);
-    dtNode->tarjanLca = nullptr;
-    dtNode->DisjointCluster::init ();
-  }
+  const TreeLca lcaIndex (*this);
   for (Dissim& dissim : dissims)
-    dissim. lca = nullptr;
-  const_static_cast <DTNode*> (root) -> setLca ();
+    if (dissim. valid ())
+    {
+      const DTNode* lca = static_cast <const DTNode*> (lcaIndex. getLca (dissim. leaf1, dissim. leaf2));
+      ASSERT (lca);
+      dissim. lca = lca->asSteiner ();
+      ASSERT (dissim. lca);
+    }
+    else
+      dissim. lca = nullptr;
 }
 
 
@@ -6043,45 +7116,129 @@ void DistTree::clearSubtreeLen ()
 namespace
 {
 
-void setPredictionAbsCriterion_thread (size_t from,
-                                       size_t to,
-                                       Real &absCriterion,
-                                       Vector<Dissim> &dissims)
+void setDissimPrediction (Dissim &dissim,
+                          Tree::LcaBuffer &buf)
+{
+  if (dissim. valid ())
+    dissim. prediction = DistTree::path2prediction (dissim. getPath (buf));
+}
+
+
+
+void setDissimPredictions_thread (size_t from,
+                                  size_t to,
+                                  Notype /*&res*/,
+                                  Vector<Dissim> &dissims,
+                                  const Vector<uint> &dissimNums)
+// Input: from, to: indexes of dissimNums
 {
-  absCriterion = 0.0;
   Tree::LcaBuffer buf;
-  Progress prog (dissims. size (), dissim_progress); 
   FOR_START (size_t, i, from, to)
+    setDissimPrediction (dissims [dissimNums [i]], buf);
+}
+
+
+
+template <typename Update /*void update (Dissim&, Tree::LcaBuffer&)*/>
+  void reduceDissims_thread (size_t from,
+                             size_t to,
+                             Notype /*&res*/,
+                             Vector<Dissim> &dissims,
+                             Vector<DistTree::DissimSums> &blockSums,
+                             bool progressP,
+                             const Update &update)
+  // Input: from, to: block numbers
+  // Scalar: the time is reading dissims[], a columnar copy of a block is slower
   {
-    Dissim& dissim = dissims [i];
-    if (! dissim. valid ())
-      continue;
-    prog ();
-    const VectorPtr<Tree::TreeNode>& path = dissim. getPath (buf);
-    dissim. prediction = DistTree::path2prediction (path);  
-    if (dissim. mult < inf)
-      absCriterion += dissim. getAbsCriterion ();
+    Tree::LcaBuffer buf;
+    Progress prog (to - from, progressP ? dissim_progress / DistTree::dissimBlock_size : 0);
+    FOR_START (size_t, block, from, to)
+    {
+      prog ();
+      DistTree::DissimSums& sums = blockSums [block];
+      const size_t start = block * DistTree::dissimBlock_size;
+      const size_t end = min (start + DistTree::dissimBlock_size, dissims. size ());
+      FOR_START (size_t, i, start, end)
+      {
+        Dissim& dissim = dissims [i];
+        update (dissim, buf);
+        sums. add (dissim);
+      }
+    }
   }
-  ASSERT (absCriterion < inf);
+
+
+
+template <typename Update /*void update (Dissim&, Tree::LcaBuffer&)*/>
+  DistTree::DissimSums reduceDissims (Vector<Dissim> &dissims,
+                                      bool threadsP,
+                                      bool progressP,
+                                      const Update &update)
+  // Return: DistTree::getDissimSums() after update() of each dissim
+  {
+    const size_t blocks = (dissims. size () + DistTree::dissimBlock_size - 1) / DistTree::dissimBlock_size;
+    Vector<DistTree::DissimSums> blockSums (blocks);
+    if (threadsP)
+    {
+      vector<Notype> notypes;
+      arrayThreads (true, reduceDissims_thread<Update>, blocks, notypes, ref (dissims), ref (blockSums), progressP, cref (update));
+    }
+    else
+    {
+      Notype notype;
+      reduceDissims_thread (0, blocks, notype, dissims, blockSums, progressP, update);
+    }
+    
+    DistTree::DissimSums sums;
+    for (const DistTree::DissimSums& blockSum : blockSums)
+      sums += blockSum;
+    return sums;
+  }
+
 }
 
+
+
+DistTree::DissimSums DistTree::getDissimSums () const
+{
+  return reduceDissims (var_cast (dissims), ! subDepth, false, [] (Dissim& /*dissim*/, Tree::LcaBuffer& /*buf*/) {});
 }
 
 
 
 void DistTree::setPredictionAbsCriterion ()
 {
-  if (subDepth)
-    setPredictionAbsCriterion_thread (0, dissims. size (), absCriterion, dissims);
+  absCriterion = reduceDissims ( dissims
+                               , ! subDepth
+                               , true
+                               , setDissimPrediction
+                               ). absCriterion;
+  ASSERT (absCriterion < inf);
+}
+
+
+
+void DistTree::setPredictionAbsCriterion (const Vector<uint> &dissimNums)
+{
+  if (! subDepth)
+  {
+    vector<Notype> notypes;
+    arrayThreads (true, setDissimPredictions_thread, dissimNums. size (), notypes, ref (dissims), cref (dissimNums));
+  }
   else
   {
-    absCriterion = 0.0;
-    vector<Real> absCriteria;
-    arrayThreads (true, setPredictionAbsCriterion_thread, dissims. size (), absCriteria, ref (dissims)); 
-    for (const Real x : absCriteria)
-      absCriterion += x;
-    ASSERT (absCriterion < inf);
+    Notype notype;
+    setDissimPredictions_thread (0, dissimNums. size (), notype, dissims, dissimNums);
   }
+  resyncAbsCriterion ();
+}
+
+
+
+void DistTree::resyncAbsCriterion ()
+{
+  absCriterion = getDissimSums (). absCriterion;
+  ASSERT (absCriterion < inf);
 }
 
 
@@ -6177,12 +7334,15 @@ void DistTree::setDissimMult (bool usePrediction)
   }
   
   
-  mult_sum = 0.0;
-  target2_sum = 0.0;
-  absCriterion = 0.0;
-  // Use Threads ??
-  for (Dissim& dissim : dissims)
-    setDissimMult (dissim, usePrediction);
+  const DissimSums sums (reduceDissims ( dissims
+                                      , ! subDepth
+                                      , false
+                                      , [this, usePrediction] (Dissim &dissim, Tree::LcaBuffer& /*buf*/) 
+                                          { setMult (dissim, usePrediction); }
+                                      ));
+  mult_sum     = sums. mult_sum;
+  target2_sum  = sums. target2_sum;
+  absCriterion = sums. absCriterion;
   ASSERT (absCriterion < inf);
 }
 
@@ -6194,6 +7354,25 @@ void DistTree::setDissimMult (Dissim& dissim,
   ASSERT (optimizable ());
   ASSERT (absCriterion < inf);  
 
+  if (! dissim. valid ())
+    return;
+    
+  setMult (dissim, usePrediction);
+
+  if (dissim. mult < inf)
+  {
+    absCriterion += dissim. getAbsCriterion ();
+    mult_sum     += dissim. mult;
+    target2_sum  += dissim. mult * sqr (dissim. target);
+  }
+  ASSERT (absCriterion < inf);
+}
+
+
+
+void DistTree::setMult (Dissim& dissim,
+                        bool usePrediction) const
+{
   if (! dissim. valid ())
     return;
 
@@ -6212,14 +7391,6 @@ void DistTree::setDissimMult (Dissim& dissim,
       ASSERT (dissim. mult < inf);
     }
   }
-
-  if (dissim. mult < inf)
-  {
-    absCriterion += dissim. getAbsCriterion ();
-    mult_sum     += dissim. mult;
-    target2_sum  += dissim. mult * sqr (dissim. target);
-  }
-  ASSERT (absCriterion < inf);
 }
 
 
@@ -6563,14 +7734,9 @@ bool DistTree::optimizeLenWhole ()
   node2deformationPair. clear ();
   
   // beta
-  Real covar = 0.0;
-  Real predict2 = 0.0;
-  for (const Dissim& dissim : dissims)  
-    if (dissim. validMult ())
-    {
-      covar    += dissim. mult * dissim. target * dissim. prediction;
-      predict2 += dissim. mult * sqr (dissim. prediction);
-    }
+  const DissimSums sums (getDissimSums ());
+  const Real covar    = sums. covar;
+  const Real predict2 = sums. predict2;
   if (covar <= 0.0)
   {
   #if 0
@@ -6601,14 +7767,14 @@ bool DistTree::optimizeLenWhole ()
   }
 
   const Real absCriterion_old = absCriterion;
-  absCriterion = 0.0;
-  for (Dissim& dissim : dissims)  
-  {
-    if (dissim. validMult ())
-      dissim. prediction *= beta;
-    if (dissim. mult < inf)
-      absCriterion += dissim. getAbsCriterion ();
-  }
+  absCriterion = reduceDissims ( dissims
+                               , ! subDepth
+                               , false
+                               , [beta] (Dissim &dissim, Tree::LcaBuffer& /*buf*/) 
+                                   { if (dissim. validMult ())
+                                       dissim. prediction *= beta;
+                                   }
+                               ). absCriterion;
   ASSERT (absCriterion < inf);
   if (! leRealRel (absCriterion, absCriterion_old, 1e-3))  // PAR
     BAD_CRITERION (optimizeLenWhole);
@@ -6702,6 +7868,8 @@ size_t DistTree::optimizeLenArc ()
           maximize (absCriterion, 0.0);
         }
       }
+      // Drift of the incremental updates
+      resyncAbsCriterion ();
     
     #if 1
       progIter (absCriterion2str ());
@@ -7339,47 +8507,148 @@ void DistTree::tryChange (Change* ch,
   ASSERT (! isNan (ch->improvement));
   ch->restore ();
 
-  Unverbose unv;
-  if (verbose ())
+  Unverbose unv;
+  if (verbose ())
+  {
+    ch->saveText (cout); 
+    cout << endl;
+  }
+  
+  if (Change::strictlyBetter (ch, bestChange))
+  {
+    delete bestChange;
+    bestChange = ch;
+  }
+  else
+    delete ch;
+}
+
+
+
+namespace
+{
+
+struct LargeImage
+{
+  Image* image {nullptr};
+  const Steiner* subTreeRoot {nullptr};
+    // nullptr <=> top subgraph
+  VectorPtr<Tree::TreeNode> possibleBoundary;
+  const VectorPtr<Change>* changes {nullptr};
+};
+
+
+
+Vector<VectorPtr<Change>> partitionChanges (const VectorOwn<Change> &changes,
+                                            const VectorPtr<Steiner> &boundary)
+// Return: parallel to boundary + top subgraph
+//         [i]: Change's whose from is in the subtree of boundary[i] and not in the subtrees of the boundary nodes below boundary[i], in the order of changes
+// Requires: boundary: cuts of DistTree::optimizeLargeSubgraphs(), isTransient()
+// Time: O(n + |changes|)
+{
+  Vector<VectorPtr<Change>> parts (boundary. size () + 1);
+
+  unordered_map<const Tree::TreeNode*, size_t> node2part;  node2part. rehash (2 * changes. size () + boundary. size ());
+  FFOR (size_t, i, boundary. size ())
+  {
+    ASSERT (boundary [i] -> isTransient ());
+    node2part [boundary [i]] = i;
+  }
+
+  VectorPtr<Tree::TreeNode> path;  path. reserve (256);  // PAR
+  for (const Change* change : changes)
   {
-    ch->saveText (cout); 
-    cout << endl;
+    ASSERT (change);
+    ASSERT (change->from);
+    ASSERT (! change->from->isTransient ());
+    size_t part = boundary. size ();
+    path. clear ();
+    const Tree::TreeNode* node = change->from;
+    while (node)
+    {
+      if (const size_t* p = findPtr (node2part, node))
+      {
+        part = *p;
+        break;
+      }
+      path << node;
+      node = node->getParent ();
+    }
+    for (const Tree::TreeNode* pathNode : path)
+      node2part [pathNode] = part;
+    parts [part] << change;
   }
-  
-  if (Change::strictlyBetter (ch, bestChange))
+
+  return parts;
+}
+
+
+
+void processLargeImages_thread (const Vector<LargeImage>* largeImages,
+                                atomic<size_t>* next)
+// Input: *next: index of the next LargeImage in *largeImages to process
+{ 
+  ASSERT (largeImages);
+  ASSERT (next);
+  for (;;)
   {
-    delete bestChange;
-    bestChange = ch;
+    const size_t i = next->fetch_add (1);
+    if (i >= largeImages->size ())
+      break;
+    const LargeImage& li = (*largeImages) [i];
+    li. image->processLarge (li. subTreeRoot, li. possibleBoundary, li. changes); 
   }
-  else
-    delete ch;
 }
 
 
 
-namespace
+void subPaths2paths_thread (const VectorPtr<Image>* images,
+                            Vector<Vector<Subgraph::SubPathTree>>* subPathTrees,
+                            atomic<size_t>* next)
+// Input: *next: index of the next Image in *images to process
+// Output: *subPathTrees: parallel to *images
 {
-
-void processLargeImage_thread (Image &image,
-                               const Steiner* subTreeRoot,
-                               const VectorPtr<Tree::TreeNode> possibleBoundary,  // needs a copy
-                               const VectorOwn<Change>* changes)
-{ 
-  image. processLarge (subTreeRoot, possibleBoundary, changes); 
+  ASSERT (images);
+  ASSERT (subPathTrees);
+  ASSERT (next);
+  for (;;)
+  {
+    const size_t i = next->fetch_add (1);
+    if (i >= images->size ())
+      break;
+    var_cast ((*images) [i]) -> subgraph. subPaths2paths ((*subPathTrees) [i]);
+  }
 }
 
 }
                         
 
 
-void DistTree::optimizeLargeSubgraphs (const VectorOwn<Change>* changes)
+size_t DistTree::getImagesMemory () const
+{
+  constexpr size_t overhead = 2;  // PAR
+    // Vector capacities, memory allocation
+  size_t pathDissimNums_size = 0;
+  for (const DiGraph::Node* node : nodes)
+    pathDissimNums_size += static_cast <const DTNode*> (node) -> pathDissimNums. size ();
+  // Image::subgraph.subPaths, Image::tree
+  return overhead * (  dissims. size () * (sizeof (SubPath) + sizeof (Dissim))
+                     + pathDissimNums_size * sizeof (uint)
+                     + nodes. size () * sizeof (Steiner)
+                    );
+}
+
+
+
+void DistTree::optimizeLargeSubgraphs (const VectorOwn<Change>* changes,
+                                       uint attempt)
 {
   ASSERT (threads_max);
   
   
   node2deformationPair. clear ();
 
-  const bool threadsUsed = (threads_max > 1 && ! subDepth);
+  const bool threadsUsed = (threads_max > 1 && ! subDepth && ! attempt);
   
 //unique_ptr<const Chronometer_OnePass> cop (subDepth == 1 ? new Chronometer_OnePass ("optimizeLargeSubgraphs for " + toString (name2leaf. size ())) : nullptr);   
   
@@ -7400,6 +8669,41 @@ void DistTree::optimizeLargeSubgraphs (const VectorOwn<Change>* changes)
   size_t parts_max = threads_max;  
   if (! threadsUsed)
     parts_max = (size_t) ceil (6.0 * log ((Real) largeParts + 0.5)) + 1;  // PAR  
+  // After bad_alloc: attempt 1 is without threads, next attempts use smaller cuts
+  if (attempt > 1)
+  {
+    FOR (uint, i, attempt - 2)
+      parts_max *= 2;
+    if (parts_max < largeParts + 1)
+      parts_max *= 2;
+    else
+    {
+      // Cuts cannot be made smaller
+      if (! subDepth)
+        section ("Optimizing small subgraphs instead of large subgraphs", false);
+      if (changes)
+        applyChanges (*changes, true); 
+      else
+        optimizeSmallSubgraphs (areaRadius_std);
+      return;
+    }
+  }
+
+  // Number of Image's processed at the same time
+  size_t images_max = threadsUsed ? threads_max : 1;
+  if (subgraphs_memory_max && ! subDepth)
+  {
+    // Memory of an Image ~ memory / parts
+    const size_t memory = getImagesMemory ();
+    if (memory > subgraphs_memory_max)
+    {
+      maximize (parts_max, (size_t) ceil ((Real) memory * (Real) images_max / (Real) subgraphs_memory_max));
+      minimize (parts_max, largeParts + 1);
+      minimize (images_max, max<size_t> (1, (size_t) ((Real) subgraphs_memory_max * (Real) parts_max / (Real) memory)));
+    }
+    if (verbose (1))
+      cerr << "Large subgraphs memory: " << memory / 1000000 << " MB  parts: " << parts_max << "  at the same time: " << images_max << endl;
+  }
   minimize (parts_max, largeParts + 1);
   ASSERT (parts_max >= 2);
 
@@ -7496,54 +8800,152 @@ void DistTree::optimizeLargeSubgraphs (const VectorOwn<Change>* changes)
 
 
   bool failed = false;
+  Vector<uint> inexactDissimNums;
   {
     VectorOwn<Image> images;  images. reserve (boundary. size ());
     Image mainImage (*this);  
     {
-      unique_ptr<Threads> th;
-      if (threadsUsed)
-        th. reset (new Threads (boundary. size ()));
+      // Image::processLarge() filters only the Change's of its part
+      Vector<VectorPtr<Change>> parts;
+      if (changes)
+        parts = partitionChanges (*changes, boundary);
+      const auto partChanges = [changes, &parts] (size_t i) -> const VectorPtr<Change>*
+        { return changes ? & parts [i] : nullptr; };
       VectorPtr<Tree::TreeNode> possibleBoundary;  possibleBoundary. reserve (boundary. size ());
-      Progress prog (boundary. size () + 1, ! threadsUsed);
-      for (const Steiner* cut : boundary)
-      {
-        prog ();
-        ASSERT (cut);
-        ASSERT (cut->isTransient ());
-        auto image = new Image (*this);
-        images << image;
-        ASSERT (cut->isTransient ());
-        if (th. get ())
-          *th << thread (processLargeImage_thread, ref (*image), cut, possibleBoundary, changes);
-            // Use functional ??
-        else
-          image->processLarge (cut, possibleBoundary, changes);
-        possibleBoundary << cut;
-      }   
-      // Top subgraph
-      prog ();
+      if (images_max > 1)
       {
+        Vector<LargeImage> largeImages;  largeImages. reserve (boundary. size () + 1);
+        for (const Steiner* cut : boundary)
+        {
+          ASSERT (cut);
+          ASSERT (cut->isTransient ());
+          auto image = new Image (*this);
+          images << image;
+          largeImages << LargeImage {image, cut, possibleBoundary, partChanges (images. size () - 1)};
+          possibleBoundary << cut;
+        }
+        // Top subgraph
+        largeImages << LargeImage {& mainImage, nullptr, possibleBoundary, partChanges (boundary. size ())};
+        const size_t threads = min (images_max, largeImages. size ());
+        atomic<size_t> next (0);
+        Threads th (threads - 1);
+        FFOR_START (size_t, i, 1, threads)
+          th << thread (processLargeImages_thread, & largeImages, & next);
         Unverbose unv;
-        mainImage. processLarge (nullptr, possibleBoundary, changes);
+        processLargeImages_thread (& largeImages, & next);
+      }
+      else
+      {
+        Progress prog (boundary. size () + 1);
+        for (const Steiner* cut : boundary)
+        {
+          prog ();
+          ASSERT (cut);
+          ASSERT (cut->isTransient ());
+          auto image = new Image (*this);
+          images << image;
+          image->processLarge (cut, possibleBoundary, partChanges (images. size () - 1));
+          possibleBoundary << cut;
+        }   
+        // Top subgraph
+        prog ();
+        {
+          Unverbose unv;
+          mainImage. processLarge (nullptr, possibleBoundary, partChanges (boundary. size ()));
+        }
       }
     }
-    // Image::apply() can be done by Threads if it is done in the order of cuts and for sibling subtrees ??!
-    {
-      Progress prog (images. size () + 1);
-      Unverbose unv;
-      if (! mainImage. apply ())
+    // bad_alloc
+    if (! mainImage. tree)
+      failed = true;
+    for (const Image* image : images)
+      if (! image->tree)
         failed = true;
-      prog (absCriterion2str ()); 
-      for (const Image* image : images)
+    if (! failed)
+    {
+      const auto applyStart = chrono::steady_clock::now ();
+      double pathsTime = 0.0;
+      if (threadsUsed)
+      {
+        // Image::applyTopology() is sequential, Subgraph::subPaths2paths() is parallel since the areas of Image's have disjoint interiors,
+        // Subgraph::paths2tree() and Image::applyFinish() are done in the order of cuts
+        VectorPtr<Image> applied;  applied. reserve (images. size () + 1);
+        applied << & mainImage;
+        for (const Image* image : images)
+          applied << image;
+        {
+          Unverbose unv;
+          for (const Image* image : applied)
+            EXEC_ASSERT (var_cast (image) -> applyTopology ());
+        }
+        Vector<Vector<Subgraph::SubPathTree>> subPathTrees (applied. size ());
+        {
+          const auto pathsStart = chrono::steady_clock::now ();
+          const size_t threads = min (threads_max, applied. size ());
+          atomic<size_t> next (0);
+          if (threads > 1)
+          {
+            Threads th (threads - 1);
+            FFOR_START (size_t, i, 1, threads)
+              th << thread (subPaths2paths_thread, & applied, & subPathTrees, & next);
+            subPaths2paths_thread (& applied, & subPathTrees, & next);
+          }
+          else
+            subPaths2paths_thread (& applied, & subPathTrees, & next);
+          pathsTime = chrono::duration<double> (chrono::steady_clock::now () - pathsStart). count ();
+        }
+        Progress prog (applied. size ());
+        Unverbose unv;
+        FFOR (size_t, i, applied. size ())
+        {
+          Image* image = var_cast (applied [i]);
+          image->subgraph. paths2tree (subPathTrees [i]);
+          subPathTrees [i]. wipe ();
+          image->applyFinish ();
+          prog (absCriterion2str () + (i ? " (approx.)" : ""));
+        }
+        qcPaths ();
+      }
+      else
+      {
+        Progress prog (images. size () + 1);
+        Unverbose unv;
+        EXEC_ASSERT (mainImage. apply ());
+        prog (absCriterion2str ()); 
+        for (const Image* image : images)
+        {
+          EXEC_ASSERT (var_cast (image) -> apply ());
+          prog (absCriterion2str () + " (approx.)" /*+ " " + to_string (image->subgraph. subPaths. size ())*/); 
+        }
+      }
+      if (threadsUsed && verbose (1))
       {
-        if (! failed && ! var_cast (image) -> apply ())
-          failed = true;
-        prog (absCriterion2str () + " (approx.)" /*+ " " + to_string (image->subgraph. subPaths. size ())*/); 
+        const double applyTime = chrono::duration<double> (chrono::steady_clock::now () - applyStart). count ();
+        const OColor c (cerr, Color::green, false, true);
+        cerr << "Image::apply: " << real2str (applyTime, 1, false) << " sec., parallel part: " << real2str (pathsTime, 1, false) << " sec." << endl;
       }
+      // Image's have been processed before the previous Image's were apply()'ed
+      mainImage. subgraph. subPaths2dissimNums (inexactDissimNums);
+      for (const Image* image : images)
+        image->subgraph. subPaths2dissimNums (inexactDissimNums);
+      dissimNums2shared (inexactDissimNums);
     }
   }
   if (failed)
-    throw runtime_error (FUNC "OUT OF MEMORY");   // if threads_num > 1 then try thread-free execution ??
+  {
+    // The tree has not been changed except for boundary
+    for (const Steiner* st : boundary)
+    {
+      ASSERT (st->graph == this);
+      ASSERT (st->isTransient ());
+      delayDeleteRetainArcs (var_cast (st));
+    }
+    toDelete. deleteData ();
+    if (! subDepth)
+      section ("Not enough memory for large subgraphs, retrying", false);
+    optimizeLargeSubgraphs (changes, attempt + 1);
+    return;
+  }
     
   // DTNode::stable
   for (DiGraph::Node* node : nodes)
@@ -7564,13 +8966,15 @@ void DistTree::optimizeLargeSubgraphs (const VectorOwn<Change>* changes)
   }
   toDelete. deleteData ();
   
-  setPredictionAbsCriterion ();
+  setPredictionAbsCriterion (inexactDissimNums);
   qc ();
   qcPaths ();
   
   if (! subDepth)
     section ("Optimizing cut nodes", false);
   optimizeSmallSubgraphsUnstable (areaRadius_std);  // PAR
+  if (! subDepth)
+    packPathDissimNums ();
   qc ();
   qcPredictionAbsCriterion ();
 }
@@ -9278,14 +10682,14 @@ Vector<LeafPair> DistTree::getMissingLeafPairs_subgraphs () const
       for (const TreeNode* node2 : subgraph. boundary)
       {      
         const DTNode* dtNode2 = static_cast <const DTNode*> (node2);
-        const Vector<uint>& pathObjNums2 = subgraph. boundary2pathDissimNums (dtNode2);
+        const DissimNums& pathObjNums2 = subgraph. boundary2pathDissimNums (dtNode2);
         var_cast (pathObjNums2). sort ();
         for (const TreeNode* node1 : subgraph. boundary)
         {
           if (node1 == node2)
             break;
           const DTNode* dtNode1 = static_cast <const DTNode*> (node1);
-          const Vector<uint>& pathObjNums1 = subgraph. boundary2pathDissimNums (dtNode1);
+          const DissimNums& pathObjNums1 = subgraph. boundary2pathDissimNums (dtNode1);
           if (pathObjNums1. intersectsFast_merge (pathObjNums2))
             continue;
           LeafPair leafPair (subgraph. getReprLeaf (dtNode1), subgraph. getReprLeaf (dtNode2));
@@ -9657,27 +11061,47 @@ void NewLeaf::Leaf2dissim::qc () const
 
 // DissimLine
 
-DissimLine::DissimLine (string &line,
-                        uint lineNum)
+DissimLine::DissimLine (string_view line)
 { 
-  replace (line, '\t', ' ');
-  name1 = findSplit (line);
-  name2 = findSplit (line);
-  #define MSG  getErrorStr (lineNum) + 
+  // ' ' = '\t'
+  const auto split = [&line] () 
+    { const size_t pos = line. find_first_of (" \t");
+      const string_view before (line. substr (0, pos));
+      line. remove_prefix (pos == string_view::npos ? line. size () : pos + 1);
+      return before;
+    };
+  name1 = split ();
+  name2 = split ();
   if (name2. empty ())
-    throw runtime_error (MSG "empty name2");
+    throw runtime_error ("empty name2");
   if (name1 == name2)
-    throw runtime_error (MSG "name1 == name2");
+    throw runtime_error ("name1 == name2");
   if (name1 > name2)
     swap (name1, name2);
-  dissim = str2real (line);
+  if (line. find ('\t') == string_view::npos)
+    dissim = str2real_fast (line);
+  else
+  {
+    string s (line);
+    replace (s, '\t', ' ');
+    dissim = str2real (s);
+  }
   if (isNan (dissim))
-    throw runtime_error (MSG "dissimilarity is NaN");
+    throw runtime_error ("dissimilarity is NaN");
   if (dissim < 0.0)
-    throw runtime_error (MSG "dissimilarity is negative");
+    throw runtime_error ("dissimilarity is negative");
 //if (! DM_sp::finite (dissim))
-  //throw runtime_error (MSG "dissimilarity is infinite");
-  #undef MSG
+  //throw runtime_error ("dissimilarity is infinite");
+}
+
+
+
+DissimLine::DissimLine (const string &line,
+                        uint lineNum)
+{ 
+  try { *this = DissimLine (string_view (line)); }
+    catch (const exception &e)
+      { throw runtime_error (getErrorStr (lineNum) + e. what ()); }
 }
 
 
@@ -9704,19 +11128,7 @@ void DissimLine::process (const DistTree::Name2leaf &name2leaf)
 
 void DissimLine::apply (DistTree &tree) const
 { 
-  ASSERT (! isNan (dissim));
-  ASSERT (dissim >= 0.0);
-  if (! leaf1)
-    return;
-  if (! leaf2)
-    return;
-  if (   /*! DistTree_sp::variance_min 
-      &&*/ ! dissim 
-      && ! leaf1->getCollapsed (leaf2)  // Only for new Leaf's
-     )  
-    leaf1->collapse (leaf2);
-  if (! tree. addDissim (leaf1, leaf2, dissim, 1.0/*temporary*/, no_index))
-    throw runtime_error (FUNC "Cannot add dissimilarity: " + name1 + " " + name2 + " " + toString (dissim));
+  tree. addLoadedDissim (leaf1, leaf2, dissim);
 }
 
 
@@ -9730,6 +11142,347 @@ bool DissimLine::operator< (const DissimLine &other) const
 
 
 
+// DissimBin
+
+namespace
+{
+  
+constexpr uint32_t dissimBin_version = 1;
+const string dissimBin_magic ("DissimBin");
+
+
+struct DissimBinHeader
+{
+  char magic [16];
+  uint32_t version {dissimBin_version};
+  uint32_t reserved {0};
+  
+  DissimBinHeader ()
+    { memset (magic, 0, sizeof (magic));
+      memcpy (magic, dissimBin_magic. c_str (), dissimBin_magic. size ());
+    }
+};
+
+
+struct DissimBinBlock
+{
+  char type {'\0'};
+    // 'N': names, 'D': DissimBin::Record's
+  uint8_t reserved [7] {0, 0, 0, 0, 0, 0, 0};
+  uint64_t num {0};
+  uint64_t bytes {0};
+    // Multiple of 8 to align the next block
+};
+
+
+static_assert (sizeof (DissimBinHeader) == 24);
+static_assert (sizeof (DissimBinBlock)  == 24);
+
+
+
+uint64_t dissimBin_align (size_t bytes)
+{
+  return (bytes + 7) / 8 * 8;
+}
+
+
+
+void dissimBin_writeBlock (ostream &os,
+                           char type,
+                           size_t num,
+                           const char* data,
+                           size_t bytes)
+{
+  DissimBinBlock block;
+  block. type = type;
+  block. num = num;
+  block. bytes = dissimBin_align (bytes);
+  writeBin (os, block);
+  os. write (data, (streamsize) bytes);
+  FOR_START (uint64_t, i, bytes, block. bytes)
+    os. put ('\0');
+}
+
+
+
+void dissimBin_writeNames (ostream &os,
+                           const StringVector &names)
+{
+  if (names. empty ())
+    return;
+  string pool;
+  for (const string& name : names)
+  {
+    pool += name;
+    pool += '\0';
+  }
+  dissimBin_writeBlock (os, 'N', names. size (), pool. c_str (), pool. size ());
+}
+
+}
+
+
+
+DissimBin::DissimBin (const string &fName_arg)
+: fName (fName_arg)
+{
+  if (! fileExists (fName))
+    return;
+    
+#ifndef _MSC_VER
+  mf. reset (new MappedFile (fName, true));
+  size_t pos = 0;
+
+  DissimBinHeader header;
+  mf->readBin (pos, header);
+  if (strncmp (header. magic, dissimBin_magic. c_str (), sizeof (header. magic)))
+    throw runtime_error (FUNC + strQuote (fName) + " is not a binary dissimilarity file");
+  if (header. version != dissimBin_version)
+    throw runtime_error (FUNC + strQuote (fName) + ": unsupported binary dissimilarity file version " + to_string (header. version));
+
+  while (pos < mf->size)
+  {
+    DissimBinBlock block;
+    mf->readBin (pos, block);
+    if (pos + block. bytes > mf->size)
+      throw runtime_error (FUNC + strQuote (fName) + " is truncated");
+    const char* data = mf->data + pos;
+    const char* end  = data + block. bytes;
+    switch (block. type)
+    {
+      case 'N':
+        FOR (uint64_t, i, block. num)
+        {
+          const char* nul = static_cast <const char*> (memchr (data, '\0', (size_t) (end - data)));
+          if (! nul)
+            throw runtime_error (FUNC + strQuote (fName) + ": name is not terminated");
+          names << string (data, nul);
+          data = nul + 1;
+        }
+        if (names. size () >= (size_t) numeric_limits<uint32_t>::max ())
+          throw runtime_error (FUNC + strQuote (fName) + ": too many names");
+        break;
+      case 'D':
+        if (block. num * sizeof (Record) > block. bytes)
+          throw runtime_error (FUNC + strQuote (fName) + " is damaged");
+        if (block. num)
+          blocks << pair<const Record*,size_t> (mf->getArray<Record> (pos), block. num);
+        break;
+      default:
+        throw runtime_error (FUNC + strQuote (fName) + ": unknown block type");
+    }
+    pos += block. bytes;
+  }
+#else
+  NOT_IMPLEMENTED;
+#endif
+}
+
+
+
+bool DissimBin::isDissimBin (const string &fName)
+{
+  ifstream f (fName, ios_base::binary | ios_base::in);
+  if (! f. good ())
+    return false;
+  DissimBinHeader header;
+  readBin (f, header);
+  return    f. good ()
+         && ! strncmp (header. magic, dissimBin_magic. c_str (), sizeof (header. magic));
+}
+
+
+
+void DissimBin::append (const string &fName,
+                        const string &textFName)
+{
+  ASSERT (! fName. empty ());
+
+  StringVector newNames;
+  Vector<Record> records;
+  {
+    unordered_map<string,uint32_t> name2id;
+    {
+      const DissimBin db (fName);
+      name2id. rehash (db. names. size ());
+      FFOR (size_t, i, db. names. size ())
+        name2id [db. names [i]] = (uint32_t) i;
+    }
+    const auto getId = [&name2id, &newNames] (const string &name) 
+      { const auto it = name2id. find (name);
+        if (it != name2id. end ())
+          return it->second;
+        const size_t id = name2id. size ();
+        if (id >= (size_t) numeric_limits<uint32_t>::max ())
+          throw runtime_error (FUNC "Too many names");
+        name2id [name] = (uint32_t) id;
+        newNames << name;
+        return (uint32_t) id;
+      };
+    
+    section ("Loading " + textFName, true);
+    LineInput f (textFName, dissim_progress);  
+    while (f. nextLine ())
+    {
+      const DissimLine dl (f. line, f. lineNum);
+      if (! DM_sp::finite (dl. dissim))
+        continue;
+      Record rec;
+      rec. id1 = getId (dl. name1);
+      rec. id2 = getId (dl. name2);
+      if (rec. id1 > rec. id2)
+        swap (rec. id1, rec. id2);
+      rec. dissim = dl. dissim;
+      records << rec;
+    }
+  }
+  
+  section ("Sorting dissimilarities", true);
+  stable_sort (records. begin (), records. end ());
+  // The last one of the equal Record's overrides the others
+  size_t j = 0;
+  FFOR (size_t, i, records. size ())
+    if (   i + 1 == records. size ()
+        || ! (records [i] == records [i + 1])
+       )
+      records [j++] = records [i];
+  records. resize (j);
+  
+  const bool exists = fileExists (fName);
+  ofstream f (fName, ios_base::binary | ios_base::out | ios_base::app);
+  if (! exists)
+    writeBin (f, DissimBinHeader ());
+  dissimBin_writeNames (f, newNames);
+  if (! records. empty ())
+    dissimBin_writeBlock (f, 'D', records. size (), reinterpret_cast <const char*> (records. data ()), records. size () * sizeof (Record));
+  f. close ();
+  if (! f. good ())
+    throw runtime_error (FUNC "Cannot write file " + shellQuote (fName));
+}
+
+
+
+void DissimBin::compact (const string &fName)
+{
+  ASSERT (! fName. empty ());
+
+  const string tmpFName (fName + ".tmp");
+  {
+    const DissimBin db (fName);
+    ofstream f (tmpFName, ios_base::binary | ios_base::out);
+    writeBin (f, DissimBinHeader ());
+    dissimBin_writeNames (f, db. names);
+    
+    const streampos blockPos = f. tellp ();
+    DissimBinBlock block;
+    block. type = 'D';
+    writeBin (f, block);
+    {
+      Progress prog (0, dissim_progress);
+      Merger merger (db);
+      Record rec;
+      while (merger. next (rec))
+      {
+        prog ();
+        writeBin (f, rec);
+        block. num++;
+      }
+    }
+    block. bytes = block. num * sizeof (Record);
+    f. seekp (blockPos);
+    writeBin (f, block);
+
+    f. close ();
+    if (! f. good ())
+      throw runtime_error (FUNC "Cannot write file " + shellQuote (tmpFName));
+  }
+  std::filesystem::rename (tmpFName, fName);
+}
+
+
+
+void DissimBin::saveText (ostream &os) const
+{
+  const ONumber on (os, dissimDecimals, true);
+  Merger merger (*this);
+  Record rec;
+  while (merger. next (rec))
+    os << names [rec. id1] << '\t' << names [rec. id2] << '\t' << rec. dissim << '\n';
+}
+
+
+
+
+// DissimBin::Merger
+
+DissimBin::Merger::Merger (const DissimBin &db_arg)
+: db (db_arg)
+, positions (db_arg. blocks. size (), 0)
+{
+  FFOR (size_t, i, db. blocks. size ())
+    heap << i;
+  make_heap (heap. begin (), heap. end (), [this] (size_t a, size_t b) { return greater (a, b); });
+}
+
+
+
+bool DissimBin::Merger::next (Record &rec)
+{
+  if (heap. empty ())
+    return false;
+    
+  const auto cmp = [this] (size_t a, size_t b) { return greater (a, b); };
+  
+  {
+    const size_t block = heap. front ();
+    rec = db. blocks [block]. first [positions [block]];
+  }
+  if (! (   rec. id1 < rec. id2 
+         && rec. id2 < db. names. size ()
+         && rec. dissim >= 0.0
+        )
+     )
+    throw runtime_error (FUNC + strQuote (db. fName) + ": bad record");
+
+  while (! heap. empty ())
+  {
+    const size_t block = heap. front ();
+    const Record* records = db. blocks [block]. first;
+    size_t &pos = positions [block];
+    if (! (records [pos] == rec))
+      break;
+    pop_heap (heap. begin (), heap. end (), cmp);
+    heap. pop_back ();
+    pos++;
+    if (pos < db. blocks [block]. second)
+    {
+      if (! (records [pos - 1] < records [pos]))
+        throw runtime_error (FUNC + strQuote (db. fName) + ": records are not sorted");
+      heap << block;
+      push_heap (heap. begin (), heap. end (), cmp);
+    }
+  }
+  
+  return true;
+}
+
+
+
+bool DissimBin::Merger::greater (size_t block1,
+                                 size_t block2) const
+{
+  const Record& r1 = db. blocks [block1]. first [positions [block1]];
+  const Record& r2 = db. blocks [block2]. first [positions [block2]];
+  if (r2 < r1)
+    return true;
+  if (r1 < r2)
+    return false;
+  return block1 < block2;
+}
+
+
+
+
 // NewLeaf
 
 NewLeaf::NewLeaf (const DistTree &tree_arg,
@@ -9968,8 +11721,17 @@ void NewLeaf::process (bool init,
     optimize ();
   }
 
+#ifdef _MSC_VER
   saveLeaf (leafFName);
   saveRequest (requestFName);
+#else
+  // Readers of leafFName and requestFName (distTree_new -server, distTree_inc_search.sh) see only complete files
+  const string tmpSuffix (".tmp");
+  saveLeaf    (leafFName    + tmpSuffix);
+  saveRequest (requestFName + tmpSuffix);
+  moveFile (leafFName    + tmpSuffix, leafFName);
+  moveFile (requestFName + tmpSuffix, requestFName);  // requestFName is published last
+#endif
 }
 
 
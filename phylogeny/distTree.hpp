@@ -96,6 +96,10 @@ extern VarianceType varianceType;
 extern Real variancePower;
 extern Real variance_min;
 
+extern size_t subgraphs_memory_max;
+  // Max. memory of Image's processed at the same time by DistTree::optimizeLargeSubgraphs()
+  // 0 <=> unlimited
+
 
 inline VarianceType str2varianceType (const string &s)
   { size_t index = 0;
@@ -402,6 +406,158 @@ typedef  unordered_map <const DisjointCluster*, VectorPtr<Leaf>>  Cluster2Leaves
 
 
 
+struct DissimNums
+// Posting list of dissimNum's
+// Open: vec
+// Packed: sorted, compressed; read-only
+//   packedData: <block offset: uint32>*, <block>*
+//   block: <first dissimNum: uint32> <delta: varint>* of block_size dissimNum's
+//   Any change unpacks
+{
+private:
+  Vector<uint> vec;
+  Vector<uint8_t> packedData;
+  uint packedSize {0};
+public:
+  static constexpr uint block_size {64};  // PAR
+  static constexpr uint pack_min {32};  // PAR
+
+
+  bool packed () const
+    { return packedSize; }
+  size_t size () const
+    { return packed () ? packedSize : vec. size (); }
+  bool empty () const
+    { return ! size (); }
+  void clear ()
+    { vec. clear ();
+      if (packed ())
+      { packedData. wipe ();
+        packedSize = 0;
+      }
+    }
+  void reserve (size_t n)
+    { unpack ();
+      vec. reserve (n);
+    }
+  DissimNums& operator<< (uint dissimNum)
+    { unpack ();
+      vec << dissimNum;
+      return *this;
+    }
+  DissimNums& operator<< (const DissimNums &other);
+  template <typename Condition /*on dissimNum*/>
+    void filterValue (const Condition cond)
+      { unpack ();
+        vec. filterValue (cond);
+      }
+  void sort ()
+    { if (! packed ())
+        vec. sort ();
+    }
+  void uniq ();
+  bool isUniq () const;
+    // Requires: sort()'ed
+  bool contains (uint dissimNum) const;
+  bool containsFast (uint dissimNum) const;
+    // Requires: sort()'ed
+    // Time: O(log(size()))
+  bool intersectsFast_merge (const DissimNums &other) const;
+    // Requires: sort()'ed
+  size_t getMemory () const
+    { return vec. capacity () * sizeof (uint) + packedData. capacity (); }
+
+  void pack ();
+    // Output: packed() if size() >= pack_min
+    // Time: O(size() log(size()))
+  void unpack ();
+    // Output: !packed()
+private:
+  static uint read32 (const uint8_t* p)
+    { uint x;
+      memcpy (& x, p, sizeof (x));
+      return x;
+    }
+  size_t blocks () const
+    { return (packedSize + block_size - 1) / block_size; }
+public:
+
+
+  struct const_iterator
+  {
+  private:
+    const uint* it {nullptr};
+      // !packed()
+    const uint8_t* pos {nullptr};
+      // packed(): next encoded dissimNum
+    size_t left {0};
+      // packed(): number of dissimNum's starting with value
+    uint blockLeft {0};
+    uint value {0};
+  public:
+    explicit const_iterator (const uint* it_arg)
+      : it (it_arg)
+      {}
+    const_iterator (const uint8_t* pos_arg,
+                    size_t size_arg)
+      : pos (pos_arg)
+      , left (size_arg)
+      { if (left)
+          next ();
+      }
+    uint operator* () const
+      { return pos ? value : *it; }
+    const_iterator& operator++ ()
+      { if (pos)
+          next ();
+        else
+          it++;
+        return *this;
+      }
+    bool operator!= (const const_iterator &other) const
+      { return pos ? left != other. left : it != other. it; }
+  private:
+    void next ()
+      { left--;
+        if (! left)
+          return;
+        if (blockLeft)
+        { uint delta = *pos++;
+          if (delta >= 0x80)
+          { delta &= 0x7F;
+            uint shift = 7;
+            for (;;)
+            { const uint b = *pos++;
+              delta |= (b & 0x7F) << shift;
+              if (b < 0x80)
+                break;
+              shift += 7;
+            }
+          }
+          value += delta;
+          blockLeft--;
+        }
+        else
+        { value = read32 (pos);
+          pos += sizeof (uint);
+          blockLeft = block_size - 1;
+        }
+      }
+  };
+  const_iterator begin () const
+    { return packed ()
+               ? const_iterator (& packedData [blocks () * sizeof (uint)], packedSize + 1)
+               : const_iterator (vec. data ());
+    }
+  const_iterator end () const
+    { return packed ()
+               ? const_iterator (nullptr, 0)
+               : const_iterator (vec. data () + vec. size ());
+    }
+};
+
+
+
 struct DTNode : Tree::TreeNode 
 {
   friend DistTree;
@@ -415,7 +571,7 @@ struct DTNode : Tree::TreeNode
 	Real len;
 	  // Arc length between *this and *getParent()
 	  // *this is root => NaN
-  Vector<uint/*dissimNum*/> pathDissimNums; 
+  DissimNums pathDissimNums; 
     // Unique
     // Paths: function of getDistTree().dissims
     // Dissimilarity paths passing through *this arc
@@ -432,10 +588,6 @@ private:
     // Init: false
 public:
 
-  // Temporary
-private:
-  const DTNode* tarjanLca {nullptr};
-public:
 protected:
   WeightedMeanVar subtreeLen; 
     // Average subtree height 
@@ -511,9 +663,6 @@ private:
                                size_t depth,
                                const DTNode* exclude) const = 0;
     // Update: descendants (append)
-  virtual void setLca ();
-    // Off-line LCA algorithm by Tarjan
-    // Requires: !tarjanLca 
   Vector<uint/*dissimNum*/> getLcaDissimNums ();
     // Return: dissimNum's s.t. getDistTree().dissims[dissimNum].lca = this
     // Invokes: DTNode::pathDissimNums.sort()
@@ -578,7 +727,6 @@ private:
   void getDescendants (VectorPtr<DTNode> &descendants,
                        size_t depth,
                        const DTNode* exclude) const final;
-  void setLca () final;
 
   void reverseParent (const Steiner* target, 
                       Steiner* child);
@@ -693,7 +841,6 @@ private:
     { if (this != exclude)
     	  descendants << this; 
     }
-  void setLca () final;
 public:
 
   const Leaf* getDissimOther (size_t dissimNum) const;
@@ -787,6 +934,14 @@ public:
     // SubPath::dissimNum's are unique 
   Real subPathsAbsCriterion {0.0};
   
+  struct SubPathTree
+  // Path of a SubPath in the changed tree
+  {
+    const Steiner* lca {nullptr};
+      // nullptr <=> viaRoot()
+    Real prediction {NaN};
+  };
+  
   
   explicit Subgraph (const DistTree &tree_arg);
   void qc () const override;
@@ -833,6 +988,25 @@ public:
   void subPaths2tree ();
     // Update: tree: Paths, absCriterion, Dissim::prediction
     // Time: O(|subPaths| + |area| (log(|boundary| + p/n log(n)) + |subPaths| log(|area|)
+  // subPaths2tree() = subPaths2paths() + paths2tree()
+  void subPaths2paths (Vector<SubPathTree> &subPathTrees);
+    // Output: subPathTrees: parallel to subPaths
+    // Update: tree: Paths in area
+    // Can be run by threads for Subgraph's whose areas have disjoint interiors
+    // Time: O(|subPaths| + |area| (log(|boundary| + p/n log(n)) + |subPaths| log(|area|)
+  void paths2tree (const Vector<SubPathTree> &subPathTrees);
+    // Input: subPathTrees: from subPaths2paths()
+    // Update: tree: absCriterion, Dissim::{lca,prediction}
+    // Time: O(|subPaths|)
+  void subPaths2dissimNums (Vector<uint> &dissimNums_arg) const
+    // Update: dissimNums_arg: append SubPath::dissimNum's
+    { for (const SubPath& subPath : subPaths)
+        dissimNums_arg << subPath. dissimNum;
+    }
+private:
+  void deleteSubPaths ();
+    // Update: tree: Paths in area
+public:
 
   bool large () const
     { return boundary. size () > 64; } // PAR
@@ -857,7 +1031,7 @@ public:
       return Tree::getPath (subPath. node1, subPath. node2, area_root, lca_, buf);
     }
     // Requires: subPath in subPaths
-  const Vector<uint>& boundary2pathDissimNums (const DTNode* dtNode) const
+  const DissimNums& boundary2pathDissimNums (const DTNode* dtNode) const
     { return dtNode == area_root 
                ? area_underRoot->pathDissimNums
                : dtNode        ->pathDissimNums;
@@ -1110,6 +1284,10 @@ struct Image : Nocopy
     // Initially: newLeaves2boundary
   bool rootInArea {false};
   bool neighborJoinP {false};
+  bool unstableCutP {false};
+    // Set by applyTopology()
+  uint areaRadius {0};
+    // Set by copySmall()
 
   
   explicit Image (const DistTree &mainTree);
@@ -1117,17 +1295,38 @@ struct Image : Nocopy
 
 
   void processSmall (const DTNode* center_arg,
-			               uint areaRadius);
-	  // Invokes: tree->{optimizeLenArc(),optimizeLenNode(),optimizeWholeIter() or optimizeSmallSubgraphs()}
+			               uint areaRadius_arg)
+    { copySmall (center_arg, areaRadius_arg);
+      optimizeSmall ();
+    }
 	  // Time: ~ O(|area| (log(|area|) log^2(n) + |area|) + Time(optimizeWholeIter(|area|)))
+  // processSmall() in steps
+  void copySmall (const DTNode* center_arg,
+                  uint areaRadius_arg);
+    // Output: subgraph, tree, new2old, rootInArea, areaRadius
+    // Reads subgraph.tree
+  void optimizeSmall ();
+    // Requires: after copySmall()
+	  // Invokes: tree->{optimizeLenArc(),optimizeLenNode(),optimizeWholeIter() or optimizeSmallSubgraphs()}
+    // Does not read subgraph.tree
 	void processLarge (const Steiner* subTreeRoot,
 	                   const VectorPtr<Tree::TreeNode> &possibleBoundary,
-	                   const VectorOwn<Change>* changes);
+	                   const VectorPtr<Change>* changes);
+	  // Input: changes: superset of the Change's whose from is in the area
 	  // Time: ~ O(|area| log(|area|) log^2(n) + Time(optimizeSmallSubgraphs(|area|)))
   bool apply ();
     // Return: false <=> bad_alloc
 	  // Output: DTNode::stable = true
+    // Invokes: applyTopology(), subgraph.subPaths2tree(), applyFinish()
     // Time: ~ O(|area| log(|area|) log^2(n))
+  // apply() in steps
+  bool applyTopology ();
+    // Return: false <=> bad_alloc
+    // Update: topology of subgraph.tree in subgraph.area
+    // Time: O(|area|)
+  void applyFinish ();
+    // Requires: after applyTopology() and subgraph.subPaths2tree() or subgraph.paths2tree()
+	  // Output: DTNode::stable = true
   const DTNode* getOld2new (const DTNode* old,
                             const DiGraph::Node2Node &old2new,
                             Tree::LcaBuffer &buf) const;
@@ -1224,6 +1423,23 @@ public:
 	explicit DistTree (const string &treeFName)
 	  : DistTree (DissimParam (), treeFName, noString, noString, noString)
 	  {}
+  struct Checkpoint
+  // Position in the optimization, defined by the caller
+  {
+    uint32_t stage {0};
+    uint32_t iter {0};
+    uint32_t flags {0};
+  };
+	DistTree (const DissimParam &dissimParam_arg,
+	          const string &checkpointFName,
+	          const string &dissimFName,
+	          const string &dissimAttrName,
+	          const string &multAttrName,
+	          Checkpoint &checkpoint);
+	  // Input: checkpointFName: saved by saveCheckpoint() for the same dissimFName, dissimAttrName, multAttrName, dissimParam_arg, varianceType, variancePower, variance_min
+	  // Output: checkpoint
+	  // Invokes: loadTreeBin(), loadDissimDs(), dissimDs2dissims(false), packPathDissimNums(), getDissimSums()
+	  // Time: O(p log(n)) without the computation of paths
 	DistTree (const DissimParam &dissimParam_arg,
 	          const string &dissimFName,
 	          const string &dissimAttrName,
@@ -1238,6 +1454,8 @@ public:
 	  // Input: dataDirName: ends with '/': incremental distance tree directory:
 	  //          temporary file name       line/file format                              meaning
 	  //          -------------------       -----------------------------                 ----------------------------
+    //         [tree.bin]                 saveBinFile()                                 Used instead of tree if not older
+    //         [dissim.bin]               DissimBin                                     Used instead of dissim if not older
     //          leaf                      <obj_new> <obj1>-<obj2> <leaf_len> <arc_len>
     //         [dissim.add[-req]]
     //          search/<obj_new>/                                                       Initialization of search for <obj_new> location
@@ -1271,11 +1489,21 @@ public:
 	  // Time: ~ O(|area| (log(|area|) log^2(subgraph.tree.n) + (sparse ? log(|area|) : |area|)))
   DistTree () = default;
   Vector<DissimLine> getDissimLines (const string& fName,
-                                     size_t reserveSize,
                                      bool mayBeEmpty) const;
     // Return: sort()'ed, unique
     // Input: mayBeEmpty <=> fName contents may be empty
+    // Invokes: parseLines()
 private:
+  void loadDissimBin (const string &fName);
+    // Input: fName: DissimBin file
+    // Output: dissims[], Leaf::pathDissimNums
+    // Invokes: addLoadedDissim()
+    // Time: O(p log(blocks))
+  void addLoadedDissim (Leaf* leaf1,
+                        Leaf* leaf2,
+                        Real dissim);
+    // Input: leaf1, leaf2: may be nullptr
+    // Invokes: addDissim()
   void loadTreeDir (const string &dir);
 	  // Input: dir: Directory with a tree of <dmSuff>-files
 	  // Uses: temporary file "<dirFile>/.list"
@@ -1285,7 +1513,20 @@ private:
                             Name2steiner &name2steiner);
     // Update: name2steiner
   void loadTreeFile (const string &fName);
-    // InvokesL loadLines()
+    // Invokes: loadTreeBin() if isBinFile(fName), else loadLines()
+  void loadTreeBin (const string &fName);
+    // Input: fName: saved by saveBinFile()
+    // Invokes: loadTreeBin(mf,pos,index2node)
+#ifndef _MSC_VER
+  void loadTreeBin (const MappedFile &mf,
+                    size_t &pos,
+                    Vector<DTNode*> &index2node);
+    // Input: mf at pos: saved by saveBin()
+    // Output: topology, DTNode::{len,errorDensity,name}, Leaf::{discernible,normCriterion}, node2deformationPair,
+    //         index2node: in the order of saveBin()
+    // Update: pos
+    // Time: O(n)
+#endif
   bool loadLines (const StringVector &lines,
 		              size_t &lineNum,
 		              Steiner* parent,
@@ -1339,11 +1580,11 @@ private:
     // Invokes: reroot(true)
     // Time: O(n^3)
   //
-  void dissimDs2dissims ();
+  void dissimDs2dissims (bool setPathsP = true);
     // Update: dissimDs: delete
     // Output: dissims etc.
     //         if an object is absent in dissimDs then it is deleted from the Tree
-    // Invokes: getSelectedPairs(), setPaths()
+    // Invokes: getSelectedPairs(), if setPathsP then setPaths()
   void loadDissimPrepare (size_t pairs_max);
     // Output: Dissim::target
   bool addDissim (Leaf* leaf1,
@@ -1367,7 +1608,10 @@ private:
     }
   void setPaths (bool setDissimMultP);
     // Output: dissims::Dissim, DTNode::pathDissimNums, absCriterion
-    // Invokes: setLca(), setDissimMult()
+    // Invokes: setLca(), setDissimMult(), packPathDissimNums()
+    // Time: O(p log(n))
+  void packPathDissimNums ();
+    // Invokes: DTNode::pathDissimNums.pack()
     // Time: O(p log(n))
 public:
   Json* toJson (JsonContainer* parent_arg,
@@ -1409,6 +1653,8 @@ public:
         os << "Variance power: " << variancePower << endl;
       if (DistTree_sp::variance_min)
         os << "Min. variance: " << variance_min << endl;
+      if (subgraphs_memory_max)
+        os << "Max. large subgraphs memory, MB: " << subgraphs_memory_max / 1000000 << endl;
       dissimParam. saveText (os);
     }
 	void printInput (ostream &os) const;
@@ -1440,20 +1686,55 @@ public:
   void saveDissimCoeffs (const string &fName) const;
   void saveFeatureTree (const string &fName,
                         bool withTime) const;
+  static const string binSuff;
+  void saveBinFile (const string &fName) const;
+    // Binary snapshot of what saveText() saves, with exact DTNode::len
+    // To be loaded by loadTreeFile() via mmap()
+    // if fName.empty() then do nothing
+    // Time: O(n)
+  void saveBin (ostream &os,
+                VectorPtr<DTNode> &index2node) const;
+    // Output: index2node: depth-first order
+    // Time: O(n)
+  void saveCheckpoint (const string &fName,
+                       const Checkpoint &checkpoint) const;
+    // Binary snapshot of the optimization state and of the parameters it depends on: saveBin(), DTNode::stable, DissimType::scaleCoeff, multFixed,
+    //   Dissim::{target,prediction,mult,lca}, Steiner::pathDissimNums
+    // To be loaded by DistTree(checkpointFName)
+    // Atomic: writes fName + ".tmp" and renames it
+    // if fName.empty() then do nothing
+    // Time: O(p log(n))
+  static bool isBinFile (const string &fName);
+    // Return: fName is saved by saveBinFile()
+  static string getBinOrTextFName (const string &textFName);
+    // Return: textFName + binSuff if it exists and is not older than textFName, otherwise textFName
 
 private:
   void qcPaths ();
     // Sort: DTNode::pathDissimNums 
     // Time: ~ O(p log(n))
   void setLca ();
-    // Input: Leaf::pathDissimNums
     // Output: Dissim::lca
+    // Invokes: TreeLca
+    // Time: O(n log(n) + p)
   void clearSubtreeLen ();
     // Invokes: DTNode::subtreeLen.clear()
   void setPredictionAbsCriterion ();
     // Output: Dissim::prediction, absCriterion
+    // absCriterion does not depend on threads_max
     // Invokes: Threads
     // Time: O(p log(n) / threads_max)
+  void setPredictionAbsCriterion (const Vector<uint> &dissimNums);
+    // Input: dissimNums: Dissim's whose prediction may be inexact
+    // Output: Dissim::prediction of dissimNums, absCriterion
+    // absCriterion does not depend on threads_max
+    // Invokes: resyncAbsCriterion(), Threads
+    // Time: O(|dissimNums| log(n) / threads_max + p / threads_max)
+  void resyncAbsCriterion ();
+    // Exact resynchronization of an incrementally updated absCriterion, no paths are computed
+    // Output: absCriterion
+    // Invokes: getDissimSums()
+    // Time: O(p / threads_max)
   void qcPredictionAbsCriterion () const;
 public:
   void setDiscernibles ();
@@ -1467,12 +1748,60 @@ public:
 	void setDissimMult (bool usePrediction);
 	  // Input: multFixed
 	  // Output: Dissim::mult, absCriterion, mult_sum, target2_sum
+	  // Invokes: Threads
 private:
   void setDissimMult (Dissim& dissim,
                       bool usePrediction);
 	  // Input: multFixed
 	  // Output: dissim::mult
+	  // Update: absCriterion, mult_sum, target2_sum
+  void setMult (Dissim& dissim,
+                bool usePrediction) const;
+	  // Input: multFixed
+	  // Output: dissim::mult
 public:
+
+  struct DissimSums
+  // Sums over dissims[] with Dissim::validMult()
+  {
+    Real absCriterion {0.0};
+      // Of Dissim::getAbsCriterion()
+    Real mult_sum {0.0};
+    Real target2_sum {0.0};
+      // Of mult * target^2
+    Real covar {0.0};
+      // Of mult * target * prediction
+    Real predict2 {0.0};
+      // Of mult * prediction^2
+
+    void add (const Dissim &dissim)
+      { if (! dissim. validMult ())
+          return;
+        const Real mult       = dissim. mult;
+        const Real target     = dissim. target;
+        const Real prediction = dissim. prediction;
+        absCriterion += dissim. getAbsCriterion ();
+        mult_sum     += mult;
+        target2_sum  += mult * target * target;
+        covar        += mult * target * prediction;
+        predict2     += mult * prediction * prediction;
+      }
+    DissimSums& operator+= (const DissimSums &other)
+      { absCriterion += other. absCriterion;
+        mult_sum     += other. mult_sum;
+        target2_sum  += other. target2_sum;
+        covar        += other. covar;
+        predict2     += other. predict2;
+        return *this;
+      }
+  };
+  static constexpr size_t dissimBlock_size {4096};  // PAR
+    // Summation unit of dissims[] 
+  DissimSums getDissimSums () const;
+    // Return: sums of dissims[] blocks of dissimBlock_size in the block order
+    //         does not depend on threads_max
+    // Invokes: Threads if !subDepth
+    // Time: O(p / threads_max)
 	  
   // Optimization	  
   bool optimizeLenWhole ();
@@ -1529,9 +1858,15 @@ private:
     // Update: bestChange: positive(improvement)
     // Invokes: Change::{apply(),restore()}
 public:
-  void optimizeLargeSubgraphs (const VectorOwn<Change>* changes);
+  void optimizeLargeSubgraphs (const VectorOwn<Change>* changes,
+                               uint attempt = 0);
+    // Input: attempt: number of previous attempts failed due to bad_alloc
     // Invokes: optimizeSmallSubgraphs() or applyChanges(*changes), Threads
+    // Uses: subgraphs_memory_max
 	  // Time: ~ O(threads_max n log^3(n))
+  size_t getImagesMemory () const;
+    // Return: estimated memory of Image's covering *this
+    // Time: O(n)
 
 private:
 	void optimizeSmallSubgraphs (uint areaRadius);
@@ -1726,7 +2061,8 @@ struct DissimLine
   
 
   DissimLine () = default;
-  DissimLine (string &line,
+  explicit DissimLine (string_view line);
+  DissimLine (const string &line,
               uint lineNum);
   DissimLine (const string &name1_arg,
               const string &name2_arg)
@@ -1750,6 +2086,87 @@ public:
 
 
 
+struct DissimBin
+// Binary store of the dissimilarities of a text file with lines <obj1> <obj2> <dissimilarity>
+// File format: header, blocks
+//   block of names: a name id is the number of the preceding names in the file
+//   block of Record's: sort()'ed, unique
+// Appending a text file adds a block of new names and a block of Record's
+// A Record of a later block overrides the Record's of the earlier blocks with the same ids
+// Only finite dissimilarities are stored
+{
+  struct Record
+  {
+    uint32_t id1 {0};
+    uint32_t id2 {0};
+      // id1 < id2
+    double dissim {NaN};
+    
+    bool operator< (const Record &other) const
+      { return    id1 <  other. id1
+               || (id1 == other. id1 && id2 < other. id2);
+      }
+    bool operator== (const Record &other) const
+      { return    id1 == other. id1
+               && id2 == other. id2;
+      }
+  };
+  static_assert (sizeof (Record) == 16);
+
+  const string fName;
+  StringVector names;
+    // Index: id
+#ifndef _MSC_VER
+private:
+  unique_ptr<const MappedFile> mf;
+public:
+#endif
+  Vector<pair<const Record*,size_t/*size*/>> blocks;
+    // Point to *mf
+  
+
+  explicit DissimBin (const string &fName_arg);
+    // Input: fName_arg: may not exist
+  
+
+  static bool isDissimBin (const string &fName);
+  static void append (const string &fName,
+                      const string &textFName);
+    // Update: fName: may not exist
+    // Time: O(n + p_text log(p_text)), where n = names.size(), p_text = size of textFName
+  static void compact (const string &fName);
+    // Output: fName: <= 1 block of names and <= 1 block of Record's
+    // Time: O(p log(blocks.size()))
+  void saveText (ostream &os) const;
+    // Output: os: lines <obj1> <obj2> <dissimilarity>, unique pairs
+
+
+  struct Merger
+  // Iterator over the Record's of all blocks in the order of Record::operator<, unique
+  {
+  private:
+    const DissimBin &db;
+    Vector<size_t> heap;
+      // blocks[] indexes
+    Vector<size_t> positions;
+      // Index: blocks[] index
+  public:
+    
+    explicit Merger (const DissimBin &db_arg);
+    
+    bool next (Record &rec);
+      // Return: false <=> end
+      // Output: rec
+      // Time: O(log(db.blocks.size()))
+  private:
+    bool greater (size_t block1,
+                  size_t block2) const;
+      // Return: the current Record of block1 is to be returned after that of block2
+  };
+};
+
+
+
 struct NewLeaf final : Named
 // To become Leaf
 // name = Leaf::name
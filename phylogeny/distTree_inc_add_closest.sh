@@ -68,7 +68,7 @@ $THIS/../setMinus $TMP.req2 $TMP.pair1 > $TMP.req
 
 section "New dissimilarities"
 $THIS/distTree_inc_request2dissim.sh $INC $TMP.req $INC/dissim.add
-cat $INC/dissim.add >> $INC/dissim
+$THIS/distTree_inc_dissim_add.sh $INC $INC/dissim.add
 rm $INC/dissim.add
 
 wc -l $INC/dissim
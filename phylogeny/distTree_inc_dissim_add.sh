@@ -0,0 +1,19 @@
+#!/bin/bash --noprofile
+THIS=$( dirname $0 )
+source $THIS/../bash_common.sh
+if [ $# -ne 2 ]; then
+  echo "Append dissimilarities to #1/dissim and to #1/dissim.bin if it is not older than #1/dissim"
+  echo "#1: incremental distance tree directory"
+  echo "#2: dissimilarity triples: <obj1> <obj2> <dissim>"
+  exit 1
+fi
+INC=$1
+DISSIM=$2
+
+
+if [ -e $INC/dissim.bin -a ! $INC/dissim.bin -ot $INC/dissim ]; then
+  cat $DISSIM >> $INC/dissim
+  $THIS/dissimBin $INC/dissim.bin  -add $DISSIM
+else
+  cat $DISSIM >> $INC/dissim
+fi
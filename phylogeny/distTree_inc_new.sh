@@ -122,6 +122,15 @@ else
   fi
 
 
+  SERVER_PID=""
+  if [ -e $INC/server ]; then
+    # The tree is loaded once for all iterations
+    rm -f $INC/search.sync
+    rm -f $INC/search.stop
+    $THIS/distTree_new $QC $INC/  -variance $VARIANCE  -server  $THREADS &
+    SERVER_PID=$!
+  fi
+
   ITER=0
   ITER_MAX=$( echo $OBJS | awk '{printf "%d", log($1)+3};' )
   while [ $ITER -lt $ITER_MAX ]; do
@@ -163,15 +172,29 @@ else
     $THIS/../trav  -step 1  $THREADS  $INC/search "$THIS/distTree_inc_search2bad.sh $INC %f"
 
     echo "Processing new objects"
-    $THIS/distTree_new $QC $INC/  -variance $VARIANCE
+    if [ "$SERVER_PID" ]; then
+      touch $INC/search.sync
+      while [ -e $INC/search.sync ]; do
+        if ! kill -0 $SERVER_PID 2> /dev/null; then
+          error "distTree_new -server has terminated"
+        fi
+        sleep 1
+      done
+    else
+      $THIS/distTree_new $QC $INC/  -variance $VARIANCE
+    fi
   done
+  if [ "$SERVER_PID" ]; then
+    touch $INC/search.stop
+    wait $SERVER_PID
+  fi
   $THIS/../trav  -step 1  $INC/search "$THIS/distTree_inc_search_stop.sh $INC %f"
 
 
   section "leaf, dissim.add -> tree, dissim"
 
   wc -l $INC/dissim.add
-  cat $INC/dissim.add >> $INC/dissim
+  $THIS/distTree_inc_dissim_add.sh $INC $INC/dissim.add
   $THIS/distTree_inc_dissim2indiscern.sh $INC $INC/dissim.add
   rm $INC/dissim.add
 fi
@@ -216,7 +239,7 @@ $THIS/makeDistTree $QC  $THREADS  -data $INC/  -variance $VARIANCE \
   $DELETE_CRITERION_OUTLIERS \
   $HYBRID \
   $GOOD \
-  -output_tree     $INC/tree.new \
+  -output_tree     $INC/tree.new  -output_tree_bin \
   -output_tree_tmp $INC/tree.tmp \
   -dissim_request $INC/dissim_request \
   > $INC/hist/makeDistTree.$VER
@@ -224,6 +247,7 @@ rm $INC/tree.tmp
 mv $INC/leaf $INC/hist/leaf.$VER
 cp /dev/null $INC/leaf
 mv $INC/tree.new $INC/tree
+mv $INC/tree.new.bin $INC/tree.bin
 
 if [ -s $INC/hist/leaf.$VER ]; then
   section "Database: new -> tree"
@@ -294,7 +318,7 @@ section "Additional requests"
 $THIS/distTree_inc_request2dissim.sh $INC $INC/dissim_request $INC/dissim.add-req
 if [ -s $INC/dissim.add-req ]; then
   $THIS/distTree_inc_dissim2indiscern.sh $INC $INC/dissim.add-req
-  cat $INC/dissim.add-req >> $INC/dissim
+  $THIS/distTree_inc_dissim_add.sh $INC $INC/dissim.add-req
 fi
 rm $INC/dissim.add-req
 rm $INC/dissim_request
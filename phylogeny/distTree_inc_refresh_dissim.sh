@@ -50,7 +50,7 @@ $THIS/distTree_inc_request2dissim.sh $INC $TMP.req $TMP.dissim-add
 section "Updating $INC/dissim and $INC/indiscern"
 if [ $REQ == 1 ]; then
   $THIS/distTree_inc_dissim2indiscern.sh $INC $TMP.dissim-add
-  cat $TMP.dissim-add >> $INC/dissim
+  $THIS/distTree_inc_dissim_add.sh $INC $TMP.dissim-add
 else
   mv $TMP.dissim-add $INC/dissim
   cp /dev/null $INC/indiscern
@@ -48,17 +48,58 @@ namespace
 {
 
 
+const string syncFName ("search.sync");
+const string stopFName ("search.stop");
+
+
+bool jobReady (const string &searchDir,
+               const string &name)
+// Return: search/<name>/ has a job for NewLeaf: dissim is complete and there is no unanswered request
+// Synchronization with distTree_inc_request.sh: request is deleted before dissim.add is appended to dissim and deleted
+{
+  const string nameDir (searchDir + name + "/");
+  return    fileExists (nameDir + "dissim")
+         && ! fileExists (nameDir + "request")
+         && ! fileExists (nameDir + "dissim.add");
+}
+
+
+
+void processJobs_thread (size_t from,
+                         size_t to,
+                         StringVector &errors,
+                         const DistTree &tree,
+                         const string &searchDir,
+                         const StringVector &jobs)
+// Output: errors
+{
+  FOR_START (size_t, i, from, to)
+    try
+    {
+      const NewLeaf nl (tree, searchDir, jobs [i], false);
+      nl. qc ();
+    }
+    catch (const exception &e)
+    {
+      errors << jobs [i] + ": " + e. what ();
+    }
+}
+
+
+
 struct ThisApplication : Application
 {
 	ThisApplication ()
 		: Application ("Find location of new objects in a distance tree.\n\
-Update: <incremental distance tree directory>/search/")
+Update: <incremental distance tree directory>/search/", true, false, true)
 		{
 		  version = VERSION;
 		  
 		  // Input
 		  addPositional ("data", "Directory with data ending with '\', or tree file");
 		  addFlag ("init", "Initialize search");
+		  addFlag ("server", "Keep the tree in memory and wait for the file <data>/" + syncFName + " or <data>/" + stopFName + ", then process the objects in <data>/search/ whose dissimilarities are complete and delete the file; exit after " + stopFName);
+		  addKey ("poll", "Number of seconds to wait for " + syncFName + " or " + stopFName + " in -server mode", "1");
 		  
   	//addKey ("dissim_power", "Power to raise dissimilarity in", "1");
 
@@ -83,6 +124,8 @@ Update: <incremental distance tree directory>/search/")
   {
 	  const string dataDir       = getArg ("data");
 	  const bool   init          = getFlag ("init");
+	  const bool   server        = getFlag ("server");
+	  const uint   poll          = str2<uint> (getArg ("poll"));
 
 	             //dissim_power  = str2real (getArg ("dissim_power"));      // Global
 
@@ -114,6 +157,14 @@ Update: <incremental distance tree directory>/search/")
     QC_ASSERT (name. empty () == leafFName.    empty ());
     QC_ASSERT (closest_num > 0);
     QC_IMPLY (closest_num != 1, ! closestFName. empty ());
+    if (server && ! isDirName (dataDir))
+      throw runtime_error ("-server requires an incremental distance tree directory");
+    if (server && ! name. empty ())
+      throw runtime_error ("-server excludes -name");
+    if (server && init)
+      throw runtime_error ("-server excludes -init");
+    if (! poll)
+      throw runtime_error ("-poll must be positive");
 
 
     unique_ptr<const DistTree> tree (isDirName (dataDir)
@@ -130,7 +181,49 @@ Update: <incremental distance tree directory>/search/")
       cout << endl;
     }
     
-    if (name. empty ())
+    if (server)
+    {
+      const string searchDir (dataDir + "search/");
+      const string syncFName_ (dataDir + syncFName);
+      const string stopFName_ (dataDir + stopFName);
+      size_t processed = 0;
+      for (;;)
+      {
+        // The jobs are ready before syncFName_ or stopFName_ is created
+        const bool sync = fileExists (syncFName_);
+        const bool stop = fileExists (stopFName_);
+        if (! sync && ! stop)
+        {
+          this_thread::sleep_for (chrono::seconds (poll));
+          continue;
+        }
+        StringVector jobs;
+        {
+          RawDirItemGenerator dig (0, searchDir, false);
+          string item;
+          while (dig. next (item))
+            if (jobReady (searchDir, item))
+              jobs << item;
+        }
+        jobs. sort ();
+        vector<StringVector> errors;
+        arrayThreads (true, processJobs_thread, jobs. size (), errors, cref (*tree), cref (searchDir), cref (jobs));
+        for (const StringVector& vec : errors)
+          if (! vec. empty ())
+            throw runtime_error (vec. toString ("\n"));
+        processed += jobs. size ();
+        if (verbose ())
+          cerr << "Processed: " << processed << endl;
+        if (sync)
+          removeFile (syncFName_);
+        if (stop)
+        {
+          removeFile (stopFName_);
+          break;
+        }
+      }
+    }
+    else if (name. empty ())
     {
       const string newDir (dataDir + "search/");
       DirItemGenerator dig (1, newDir, false);  // PAR
@@ -53,6 +53,41 @@ $THIS/makeDistTree  -qc  -input_tree $TMP.random-output.tree    -data $TMP  -var
 $THIS/distTree_compare_criteria.sh $TMP.randomTree.makeDistTree $DATA/randomTree.makeDistTree
 comment "Verbose"
 $THIS/makeDistTree  -qc  -input_tree $TMP.random-output.tree    -data $TMP  -variance lin  -verbose 2 &> $TMP.out
+comment "Reductions do not depend on threads"
+$THIS/benchDistTree  -qc  -input_tree $TMP.random-output.tree  -variance lin  -iter 2              $TMP | cut -f 1,3 > $TMP.bench1
+$THIS/benchDistTree  -qc  -input_tree $TMP.random-output.tree  -variance lin  -iter 2  -threads 3  $TMP | cut -f 1,3 > $TMP.bench3
+diff $TMP.bench1 $TMP.bench3
+
+section "Binary tree"
+$THIS/makeDistTree  -qc  -input_tree $TMP.random-output.tree  -output_tree $TMP.random-bin.tree  -output_tree_bin > $TMP.out
+$THIS/printDistTree -qc $TMP.random-bin.tree      -order  -decimals 4  > $TMP.random-bin.nw
+$THIS/printDistTree -qc $TMP.random-bin.tree.bin  -order  -decimals 4  > $TMP.random-bin1.nw
+diff $TMP.random-bin.nw $TMP.random-bin1.nw
+
+section "Checkpoint"
+$THIS/makeDistTree  -qc  -input_tree $TMP.random-output.tree  -data $TMP  -variance lin  -optimize  -subgraph_iter_max 1  -checkpoint $TMP.ckpt > $TMP.out
+$THIS/makeDistTree  -qc  -data $TMP  -variance lin  -optimize  -checkpoint $TMP.ckpt  -resume | grep -v '^CHRON: ' > $TMP.randomTree-resume.makeDistTree
+$THIS/distTree_compare_criteria.sh $TMP.randomTree-resume.makeDistTree $DATA/randomTree.makeDistTree
+comment "Different -variance"
+if $THIS/makeDistTree  -qc  -data $TMP  -variance linExp  -optimize  -checkpoint $TMP.ckpt  -resume &> $TMP.out; then
+  error "-resume with a different -variance"
+fi
+
+section "CompactTree"
+$THIS/randomDistTree 0.9 10000  -benchmark  -qc > $TMP.out
+
+section "Binary dissimilarities"
+mkdir $TMP.inc
+cp $TMP.random-output.tree $TMP.inc/tree
+touch $TMP.inc/leaf
+$THIS/makeDistTree  -qc  -input_tree $TMP.random-output.tree  -data $TMP  -variance lin  -output_dissim $TMP.inc/dissim > $TMP.out
+$THIS/makeDistTree  -qc  -data $TMP.inc/  -variance lin  -optimize  -output_tree $TMP.inc-text.tree > $TMP.out
+$THIS/dissimBin $TMP.inc/dissim.bin  -add $TMP.inc/dissim
+$THIS/dissimBin $TMP.inc/dissim.bin  -add $TMP.inc/dissim  -compact
+$THIS/makeDistTree  -qc  -data $TMP.inc/  -variance lin  -optimize  -output_tree $TMP.inc-bin.tree > $TMP.out
+$THIS/printDistTree -qc $TMP.inc-text.tree  -order  -decimals 4  > $TMP.inc-text.nw
+$THIS/printDistTree -qc $TMP.inc-bin.tree   -order  -decimals 4  > $TMP.inc-bin.nw
+diff $TMP.inc-text.nw $TMP.inc-bin.nw
 
 section "Salmonella"
 # Check time ??
@@ -90,6 +125,47 @@ if [ -d $DATA/inc.ITS ]; then
   diff $DATA/inc.ITS/search/NR_073289.1/request $DATA/inc.ITS/request.expected
   rm $DATA/inc.ITS/search/NR_073289.1/leaf
   rm $DATA/inc.ITS/search/NR_073289.1/request
+  comment "-server"
+  touch $DATA/inc.ITS/search.stop
+  $THIS/distTree_new -qc $DATA/inc.ITS/  -variance linExp  -server  -threads 3
+  diff $DATA/inc.ITS/search/NR_073289.1/leaf    $DATA/inc.ITS/leaf.expected
+  diff $DATA/inc.ITS/search/NR_073289.1/request $DATA/inc.ITS/request.expected
+  rm $DATA/inc.ITS/search/NR_073289.1/leaf
+  rm $DATA/inc.ITS/search/NR_073289.1/request
+  comment "-server: a new object appears while polling"
+  function server_sync
+  {
+    # As in distTree_inc_new.sh
+    touch $DATA/inc.ITS/search.sync
+    local SEC=0
+    while [ -e $DATA/inc.ITS/search.sync ]; do
+      if ! kill -0 $SERVER_PID 2> /dev/null; then
+        error "distTree_new -server has terminated"
+      fi
+      if [ $SEC -ge 600 ]; then  # PAR
+        kill $SERVER_PID
+        error "distTree_new -server does not respond"
+      fi
+      sleep 1
+      SEC=$(( SEC + 1 ))
+    done
+  }
+  mv $DATA/inc.ITS/search/NR_073289.1/dissim $TMP.dissim
+  $THIS/distTree_new -qc $DATA/inc.ITS/  -variance linExp  -server  -threads 3 &
+  SERVER_PID=$!
+  # The object has no dissim => it is skipped
+  server_sync
+  if [ -e $DATA/inc.ITS/search/NR_073289.1/leaf ] || [ -e $DATA/inc.ITS/search/NR_073289.1/request ]; then
+    error "-server processed an incomplete object"
+  fi
+  mv $TMP.dissim $DATA/inc.ITS/search/NR_073289.1/dissim
+  server_sync
+  diff $DATA/inc.ITS/search/NR_073289.1/leaf    $DATA/inc.ITS/leaf.expected
+  diff $DATA/inc.ITS/search/NR_073289.1/request $DATA/inc.ITS/request.expected
+  touch $DATA/inc.ITS/search.stop
+  wait $SERVER_PID
+  rm $DATA/inc.ITS/search/NR_073289.1/leaf
+  rm $DATA/inc.ITS/search/NR_073289.1/request
 fi
 
 section "Saccharomyces hybrids"
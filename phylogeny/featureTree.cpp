@@ -51,6 +51,10 @@ namespace FeatureTree_sp
 
 
 
+bool parsimonyBitSliced = true;
+
+
+
 // Feature
 
 void Feature::qc () const
@@ -164,7 +168,8 @@ void Phyl::init ()
 	for (const bool parentCore : {false, true})
 	{
 	  ASSERT (parent2core [parentCore]. empty ());
-		parent2core [parentCore]. resize (n); 
+	  if (parent2coreUsed ())
+		  parent2core [parentCore]. resize (n); 
 	}
 	
 	ASSERT (core. empty ());
@@ -186,10 +191,10 @@ void Phyl::qc () const
 	const size_t n = core. size ();  
   QC_IMPLY (! getFeatureTree (). oneFeatureInTree, n == getFeatureTree (). features. size ())
 	for (const bool parentCore : {false, true})
-  	QC_ASSERT (parent2core [parentCore]. size () == n);
+  	QC_ASSERT (parent2core [parentCore]. size () == (parent2coreUsed () ? n : 0));
   if (const TreeNode* parent = getParent ())
     { QC_ASSERT (static_cast <const Phyl*> (parent) -> core. size () == n); }
-	FFOR (size_t, i, core. size ())
+	FFOR (size_t, i, parent2core [false]. size ())
 	{
  	  QC_ASSERT (parent2core [false] [i]. core <= parent2core [true] [i]. core);
  	//QC_IMPLY (getFeatureTree (). allTimeZero, fabs (parent2core [false] [i]. treeLen - parent2core [true] [i]. treeLen) <= 1.001); ??
@@ -265,6 +270,14 @@ const FeatureTree& Phyl::getFeatureTree () const
 
 
 
+bool Phyl::parent2coreUsed () const
+{
+  return    ! getFeatureTree (). parsimonyBits ()
+         || ! getParent ();  // For FeatureTree::getSuperRootCore()
+}
+
+
+
 float Phyl::feature2weight (size_t /*featureIndex ??*/,
 	                          bool thisCore,
 	                          bool parentCore) const
@@ -458,8 +471,6 @@ Real Phyl::getFeatureSubtreeLength (size_t featureIndex) const
 
 void Phyl::assignFeature (size_t featureIndex)
 { 
-  var_cast (getFeatureTree ()). coreSynced = false;
-
 	float childrenCoreDistance [2/*bool thisCore*/];
 	for (const bool thisCore : {false, true})
 	{
@@ -485,22 +496,14 @@ void Phyl::assignFeature (size_t featureIndex)
 
 void Phyl::assignFeatures ()
 { 
+  var_cast (getFeatureTree ()). coreSynced = false;
+
   FFOR (size_t, i, parent2core [false]. size ())
     assignFeature (i);
 }
 
 
 
-void Phyl::assignFeaturesDown ()
-{ 
-	for (DiGraph::Arc* arc : arcs [false])
-		static_cast <Phyl*> (arc->node [false]) -> assignFeaturesDown ();
-  assignFeatures ();
-}
-
-
-
-
 // Species
 
 void Species::Movement::undo (Species* s) const
@@ -931,7 +934,7 @@ void Strain::getParent2corePooled (size_t parent2corePooled [2/*thisCore*/] [2/*
 
 
 
-void Strain::assignFeatures ()
+void Strain::assignPooled ()
 { 
   // singletonsInCore
 	float distance [2/*bool thisCore*/];
@@ -941,7 +944,7 @@ void Strain::assignFeatures ()
 	                        +    feature2weight (thisCore, false);
   singletonsInCore = distance [true] <= distance [false];
 
-  Species::assignFeatures ();
+  Species::assignPooled ();
 }
 
 
@@ -1159,8 +1162,9 @@ void Genome::init (const Vector<size_t> &featureBatch)
       }
     }
     const bool isCore = (coreSetIndex != no_index || isOptionalNominal);
-  	for (const bool parentCore : {false, true})
-      parent2core [parentCore] [i]. core = toEbool (isCore);
+    if (parent2coreUsed ())
+    	for (const bool parentCore : {false, true})
+        parent2core [parentCore] [i]. core = toEbool (isCore);
     core [i] = isCore;
     optionalCore [i] = isOptionalNominal
                          ? true
@@ -2080,6 +2084,24 @@ void genomes_initDir (size_t from,
 	      { throw runtime_error ("In genome " + g->id + ": " + e. what ()); }
   }
 }
+
+
+
+void genomes_nominals2coreSet (size_t from,
+                               size_t to,
+                               Notype /*&res*/,
+                               const VectorPtr<Genome> &genomes)
+{
+  Progress prog (to - from, 100);  // PAR
+  FOR_START (size_t, i, from, to)
+  {
+    const Genome* g = genomes [i];
+		prog ();
+    try { var_cast (g) -> nominals2coreSet (); } 
+	    catch (const exception &e)
+	      { throw runtime_error ("In genome " + g->id + ": " + e. what ()); }
+  }
+}
   
 }
 
@@ -2144,15 +2166,13 @@ FeatureTree::FeatureTree (const string &treeFName,
   if (! oneFeatureInTree)
   {
     const Chronometer_OnePass cop ("Genome: nominals to coreSet");  
-    Progress prog (genomes, displayPeriod);
     // 86 sec./50K genomes
-    // Threads ??
-   	for (const DiGraph::Node* node : nodes)
-   		if (const Genome* g = static_cast <const Phyl*> (node) -> asGenome ())
-   		{
-   		  prog ();
-   		  var_cast (g) -> nominals2coreSet (); 
-   		}
+    VectorPtr<Genome> genomeVec;  genomeVec. reserve (genomes);
+	 	for (const DiGraph::Node* node : nodes)
+	 		if (const Genome* g = static_cast <const Phyl*> (node) -> asGenome ())
+	 		  genomeVec << g;
+    vector<Notype> notypes;
+    arrayThreads (false, genomes_nominals2coreSet, genomeVec. size (), notypes, cref (genomeVec));
   }
 
 
@@ -2503,11 +2523,15 @@ void FeatureTree::processBatch (const VectorPtr<Phyl> &phyls,
  		if (const Genome* g = phyl->asGenome ())
  			var_cast (g) -> init (featureBatch);
  			
-  setLenGlobal ();  
+ 	if (parsimonyBits ())
+ 	  setLenCoreBits ();
+ 	else
+ 	{
+    setLenGlobal ();  
+    setCore ();  
+  }
   featureLen += len;
   
-  setCore ();  
-  
   // Feature::Stats; Species::middleCoreSize
  	for (const Phyl* phyl : phyls)
  	  FFOR (size_t, i, featureBatch. size ())
@@ -2912,15 +2936,292 @@ float FeatureTree::getLength () const
 
 
 
+namespace
+{
+  
+void getPostOrder (const Phyl* phyl,
+                   VectorPtr<Phyl> &postOrder)
+{
+	for (const DiGraph::Arc* arc : phyl->arcs [false])
+		getPostOrder (static_cast <const Phyl*> (arc->node [false]), postOrder);
+  postOrder << phyl;
+}
+  
+}
+
+
+
 void FeatureTree::setLenGlobal ()
 { 
-  // Threads ??
-  const_static_cast <Species*> (root) -> assignFeaturesDown ();
+  const Species* root_ = static_cast <const Species*> (root);
+  
+  VectorPtr<Phyl> postOrder;  postOrder. reserve (nodes. size ());
+  getPostOrder (root_, postOrder);
+  ASSERT (postOrder. size () == nodes. size ());
+  for (const Phyl* phyl : postOrder)
+    if (const Species* s = phyl->asSpecies ())
+    { 
+      ASSERT (! s->movementsOn); 
+    }
+  
+  coreSynced = false;
+  // Features are independent
+  vector<Notype> notypes;
+  arrayThreads (false, [] (size_t from, size_t to, Notype /*&res*/, const VectorPtr<Phyl> &postOrder_)
+                         { for (const Phyl* phyl : postOrder_)
+                             FOR_START (size_t, i, from, to)
+                               var_cast (phyl) -> assignFeature (i);
+                         }
+               , root_->parent2core [false]. size (), notypes, cref (postOrder));
+  for (const Phyl* phyl : postOrder)
+    var_cast (phyl) -> assignPooled ();
+               
+  // Deterministic
 	len = getLength ();
 }
 
 
 
+namespace
+{
+  
+typedef  uint64_t  Word;
+constexpr size_t word_bits = 64;
+
+
+struct SankoffBits
+// Of a Species for a batch of features
+// Parsimony method with 2 states: Species::weight[][] = 0/1, Genome::weight[][] = 0/inf
+//   d(c) = sum_{child} min(child.d(c), child.d(!c) + 1): length of the subtree if core = c
+//   Genome's are merged into Strain's
+{
+  size_t offset {0};
+    // In planes
+  // Bit planes
+  // free <=> !pref[false] && !pref[true] <=> d(false) = d(true)
+  static constexpr size_t pref_false {0};
+  static constexpr size_t pref_true {1};
+    // d(c) < d(!c)
+  static constexpr size_t strong {2};
+    // |d(false) - d(true)| >= 2
+  static constexpr size_t core {3};
+    // = Phyl::core
+  static constexpr size_t planes {4};
+};
+  
+}
+
+
+
+void FeatureTree::setLenCoreBits ()
+{
+  ASSERT (parsimonyBits ());
+  ASSERT (allTimeZero);
+  ASSERT (! emptySuperRoot);
+  
+  const Species* root_ = static_cast <const Species*> (root);
+  const size_t n = root_->core. size ();
+  ASSERT (n);
+  const size_t words = (n - 1) / word_bits + 1;
+  const Word lastMask = n % word_bits ? (Word (1) << (n % word_bits)) - 1 : ~Word (0);
+  
+  // Post-order
+  VectorPtr<Species> species;  species. reserve (nodes. size ());
+  {
+    VectorPtr<Species> stack;  stack. reserve (nodes. size ());
+    stack << root_;
+    while (! stack. empty ())
+    {
+      const Species* s = stack. back ();
+      stack. pop_back ();
+      species << s;
+      if (! s->asStrain ())
+        for (const DiGraph::Arc* arc : s->arcs [false])
+          stack << static_cast <const Species*> (arc->node [false]);
+    }
+    species. reverse ();
+  }
+  unordered_map<const Species*, SankoffBits> species2bits;  species2bits. rehash (species. size ());
+  FFOR (size_t, i, species. size ())
+    species2bits [species [i]]. offset = i * SankoffBits::planes * words;
+  Vector<Word> bits (species. size () * SankoffBits::planes * words, 0);
+  const auto getPlane = [&bits, &species2bits, words] (const Species* s,
+                                                     size_t plane) 
+    { return & bits [species2bits [s]. offset + plane * words]; };
+  const auto getBit = [] (const Word* plane, size_t i) 
+    { return (plane [i / word_bits] >> (i % word_bits)) & 1; };
+    
+  // Bottom-up
+  Vector<uint> rootLens (n, 0);
+    // = d(root_->core)
+  size_t arity_max = 1;
+  for (const Species* s : species)
+    maximize (arity_max, s->arcs [false]. size ());
+  size_t counterPlanes = 1;
+  while ((size_t (1) << counterPlanes) <= arity_max)
+    counterPlanes++;
+  Vector<Word> counters [2/*pref*/];  
+    // Bit-sliced counters of children with SankoffBits::pref_*
+  for (Vector<Word>& counter : counters)
+    counter. resize (counterPlanes * words);
+  Vector<Word> minPlane (words);
+  for (const Species* s : species)
+  {
+    Word* pref [2] = {getPlane (s, SankoffBits::pref_false), getPlane (s, SankoffBits::pref_true)};
+    Word* strong = getPlane (s, SankoffBits::strong);
+    if (const Strain* st = s->asStrain ())
+    {
+      const Genome* g = st->getGenome ();
+      ASSERT (g->core. size () == n);
+      // Genome::assignFeature()
+      FFOR (size_t, i, n)
+        if (! g->optionalCore [i])
+        {
+          const Word bit = Word (1) << (i % word_bits);
+          pref [g->core [i]] [i / word_bits] |= bit;
+          strong [i / word_bits] |= bit;
+        }
+    }
+    else
+    {
+      for (Vector<Word>& counter : counters)
+        counter. assign (counter. size (), 0);
+      for (const DiGraph::Arc* arc : s->arcs [false])
+      {
+        const Species* child = static_cast <const Species*> (arc->node [false]);
+        for (const bool c : {false, true})
+        {
+          const Word* childPref = getPlane (child, c);
+          Word* counter = counters [c]. data ();
+          FFOR (size_t, w, words)
+          {
+            Word carry = childPref [w];
+            FFOR (size_t, k, counterPlanes)
+            {
+              Word& x = counter [k * words + w];
+              const Word t = x & carry;
+              x ^= carry;
+              carry = t;
+            }
+            ASSERT (! carry);
+          }
+        }
+      }
+      // a = counters[false], b = counters[true]
+      // d(false) = sum_{child} child.m + b, d(true) = sum_{child} child.m + a
+      const Word* a = counters [false]. data ();
+      const Word* b = counters [true]. data ();
+      FFOR (size_t, w, words)
+      {
+        Word gt = 0;
+        Word lt = 0;
+        Word eq = ~Word (0);
+        FOR_REV (size_t, k, counterPlanes)
+        {
+          const Word ak = a [k * words + w];
+          const Word bk = b [k * words + w];
+          gt |= eq & ak & ~ bk;
+          lt |= eq & ~ ak & bk;
+          eq &= ~ (ak ^ bk);
+        }
+        pref [false] [w] = gt;
+        pref [true]  [w] = lt;
+        // strong: |a - b| >= 2
+        Word borrow = 0;
+        Word diffHigh = 0;
+        FFOR (size_t, k, counterPlanes)
+        {
+          const Word ak = a [k * words + w];
+          const Word bk = b [k * words + w];
+          const Word x = (gt & ak) | (~ gt & bk);
+          const Word y = (gt & bk) | (~ gt & ak);
+          const Word d = x ^ y ^ borrow;
+          borrow = (~ x & (y | borrow)) | (x & y & borrow);
+          if (k)
+            diffHigh |= d;
+        }
+        strong [w] = diffHigh;
+      }
+      // rootLens += min(a,b)
+      FFOR (size_t, k, counterPlanes)
+      {
+        FFOR (size_t, w, words)
+        {
+          const Word* lt = pref [true];
+          minPlane [w] = (lt [w] & a [k * words + w]) | (~ lt [w] & b [k * words + w]);
+        }
+        FFOR (size_t, w, words)
+          for (Word x = minPlane [w] & (w == words - 1 ? lastMask : ~Word (0)); x; x &= x - 1)
+            rootLens [w * word_bits + (size_t) __builtin_ctzll (x)] += uint (1) << k;
+      }
+    }
+    var_cast (s) -> assignPooled ();
+  }
+  
+  // len
+  {
+    float s = 0.0;
+    FFOR (size_t, i, n)
+      s += (float) rootLens [i];
+    len = s;
+  }
+  
+  // root_->parent2core[]: Phyl::assignFeature()
+  {
+    const Word* pref [2] = {getPlane (root_, SankoffBits::pref_false), getPlane (root_, SankoffBits::pref_true)};
+    const Word* strong = getPlane (root_, SankoffBits::strong);
+    FFOR (size_t, i, n)
+      for (const bool parentCore : {false, true})
+      {
+        const bool other = getBit (pref [! parentCore], i);
+        const ebool c = ! other 
+                          ? toEbool (parentCore) 
+                          : getBit (strong, i) 
+                            ? toEbool (! parentCore) 
+                            : enull;
+        var_cast (root_) -> parent2core [parentCore] [i] = Phyl::CoreEval ((float) (rootLens [i] + other), c);
+      }
+  }
+
+  // Top-down: Phyl::feature2core()
+  const Word tie2core = preferGain ? 0 : ~Word (0);
+  FOR_REV (size_t, j, species. size ())
+  {
+    const Species* s = species [j];
+    const Word* pref [2] = {getPlane (s, SankoffBits::pref_false), getPlane (s, SankoffBits::pref_true)};
+    const Word* strong = getPlane (s, SankoffBits::strong);
+    Word* core = getPlane (s, SankoffBits::core);
+    if (s == root_)
+      // getSuperRootCore() = pref[true]
+      FFOR (size_t, w, words)
+        core [w] = pref [true] [w];
+    else
+    {
+      const Word* parentCore = getPlane (static_cast <const Species*> (s->getParent ()), SankoffBits::core);
+      FFOR (size_t, w, words)
+      {
+        const Word p = parentCore [w];
+        const Word free = ~ (pref [false] [w] | pref [true] [w]);
+        const Word tie = ~ strong [w] & ((pref [true] [w] & ~ p) | (pref [false] [w] & p));
+        core [w] = (free & p) | (pref [true] [w] & (p | strong [w])) | (tie & tie2core);
+      }
+    }
+    FFOR (size_t, i, n)
+      var_cast (s) -> core [i] = getBit (core, i);
+    if (const Strain* st = s->asStrain ())
+    {
+      Genome* g = var_cast (st->getGenome ());
+      FFOR (size_t, i, n)
+        if (g->optionalCore [i])
+          g->core [i] = getBit (core, i);
+    }
+  }
+  
+  coreSynced = true;
+}
+
+
+
 void FeatureTree::setTimeWeight ()
 {
   ASSERT (! oneFeatureInTree);
@@ -185,6 +185,7 @@ struct Phyl : Tree::TreeNode
 	Vector<CoreEval> parent2core [2/*bool parentCore*/];
 	  // CoreEval::core: optimal given parentCore
     // size() = getFeatureTree().features.size()
+    //          0 if !parent2coreUsed()
 	float weight [2/*thisCore*/] [2/*parentCore*/];
 	  // = -log(prob); >= 0; may be inf
 	Vector<bool> core;
@@ -203,6 +204,8 @@ protected:
 public:
 	void init ();
   void qc () const override;
+  bool parent2coreUsed () const;
+    // Return: false <=> parent2core[] is replaced by FeatureTree::setLenCoreBits()
 protected:
   void saveContent (ostream& os) const override;
     // Input: core
@@ -286,10 +289,11 @@ protected:
 	  // Input: children->parent2core[]
 	virtual void assignFeatures ();
 	  // Invokes: assignFeature()
+	virtual void assignPooled ()
+	  {}
+	  // Part of assignFeatures() for the features not in getFeatureTree().features
+	  // Input: children->assignPooled()
 public:
-	void assignFeaturesDown ();
-	  // Post-order DFS
-	  // Invokes: assignFeatures()
 
   virtual void getParent2corePooled (size_t parent2corePooled [2/*thisCore*/] [2/*parentCore*/]) const;
     // Output: parent2corePooled[][]: core change for features not in getFeatureTree().features
@@ -380,8 +384,10 @@ public:
 protected:
   void assignFeatures () override
     { Phyl::assignFeatures ();
-      pooledSubtreeDistance = getPooledSubtreeDistance ();
+      assignPooled ();
     }
+  void assignPooled () override
+    { pooledSubtreeDistance = getPooledSubtreeDistance (); }
 public:
 
 private:
@@ -478,7 +484,8 @@ public:
   const Strain* asStrain () const final
     { return this; }
 
-	void assignFeatures () final;
+	void assignPooled () final;
+	  // Output: singletonsInCore
   void getParent2corePooled (size_t parent2corePooled [2/*thisCore*/] [2/*parentCore*/]) const final;
 	float getPooledSubtreeDistance () const final;
 private:
@@ -560,11 +567,12 @@ public:
 	  // Input: file "featureDir/id" with the format: `featureLineFormat()`
     //        large: files in featureDir are grouped into subdirectories named str2hash_class(<file name>)
 	  // Output: coreSet, coreNonSingletons
+	void nominals2coreSet ();
+	  // Input: getFeatureTree().nominal2values
+	  // Update: coreSet: add optional GenomeFeature's
 private:
 	void coreSet2nominals ();
 	  // Update: getFeatureTree().nominal2values, nominals
-	void nominals2coreSet ();
-	  // Update: coreSet: add optional GenomeFeature's
 	void getSingletons (Set<Feature::Id> &globalSingletons,
 	                    Set<Feature::Id> &nonSingletons) const;
     // Update: globalSingletons, nonSingletons: !intersect()
@@ -1124,6 +1132,12 @@ public:
 
 
 
+extern bool parsimonyBitSliced;
+  // FeatureTree::oneFeatureInTree && FeatureTree::allTimeZero => FeatureTree::setLenCoreBits() is used instead of Phyl::assignFeatures() 
+  // Init: true
+
+
+
 struct FeatureTree final : Tree
 // Of Phyl*
 // !allTimeZero => effectively unrooted 
@@ -1173,6 +1187,8 @@ public:
   static constexpr size_t featureBatchSize {10000};  // PAR
     // 164777 Genome's, 114555 features: 26% of RAM of lmem21
     // "Assigning features": 15 min./10000 features
+  bool parsimonyBits () const
+    { return oneFeatureInTree && allTimeZero && parsimonyBitSliced; }
 
   // Internal
 	size_t nodeIndex_max {0};
@@ -1261,6 +1277,18 @@ public:
   // OPTIMIZATION 
   // Phyl::parent2core[]
   void setLenGlobal ();
+    // Output: len
+    // Invokes: Phyl::assignFeature(), Phyl::assignPooled()
+    // Threads: features are partitioned
+private:
+  void setLenCoreBits ();
+    // Bit-sliced Sankoff algorithm for the parsimony method: 64 features of a batch per word
+    // Output: len, Phyl::core, root->parent2core[]
+    //         Species::{pooledSubtreeDistance,singletonsInCore}
+    // Requires: parsimonyBits()
+    // Invokes: Phyl::assignPooled()
+    // Time: O(n f / 64 log(max. arity) + len)
+public:
   // Phyl::core[]
   void setCore ()
     { coreSynced = true;
@@ -33,6 +33,11 @@ diff $TMP.dir/obj.core        $DIR/obj.core
 diff $TMP.dir/obj.featureTree $DIR/obj.featureTree
 set +x
 
+echo ""
+echo "Bit-sliced parsimony ..."
+sed -e '/^#/d' -e 's/ t=[^ ]*//' $TMP.dir/obj.tree > $TMP.dir/obj.parsimony.tree
+$THIS/benchFeatureTree  -qc  -input_tree $TMP.dir/obj.parsimony.tree  -features $TMP.dir/gene  -noprogress | grep -v "CHRON"
+
 
 rm -r $TMP*
 
@@ -54,6 +54,13 @@ const string criterionOutlier_definition ("normalized object criterion");
 const string deformationOutlier_definition ("relative object deformation");
 
 
+// DistTree::Checkpoint::stage: last completed stage of -optimize
+enum CheckpointStage : uint32_t {stage_none, stage_len, stage_reinsert, stage_subgraphs, stage_topology};
+  // stage_subgraphs: DistTree::Checkpoint::iter = number of completed iterations
+// DistTree::Checkpoint::flags
+constexpr uint32_t checkpoint_predictionImproved = 1;
+
+
 
 struct ThisApplication final : Application
 {
@@ -63,11 +70,12 @@ struct ThisApplication final : Application
 	  version = VERSION;
 	  
 		// Input
-	  addKey ("input_tree", "Directory with a tree of " + dmSuff + "-files ending with '/' or a tree file. If empty then neighbor-joining");
+	  addKey ("input_tree", "Directory with a tree of " + dmSuff + "-files ending with '/' or a tree file (text or binary). If empty then neighbor-joining");
 
 	  addKey ("data", dmSuff + "-file without " + strQuote (dmSuff) + "; or directory with data for an incremental tree ending with '/'");
 	  addKey ("dissim_attr", "Dissimilarity attribute name in the <data> file; if all positive two-way attributes must be used then ''");
 	  addKey ("weight_attr", "Dissimilarity weight attribute name in the <data> file");
+	  addFlag ("dissim_packed", "Store the two-way attributes of the <data> file as upper triangles of float's: 1/4 of memory; a value and its transposed value are averaged");
 
 	  addKey ("dissim_coeff", "Coefficient to multiply dissimilarity by (after dissim_power is applied)", "1");
 	  addKey ("dissim_power", "Power to raise dissimilarity in", "1");
@@ -89,11 +97,14 @@ struct ThisApplication final : Application
 	  addFlag ("optimize", "Optimize topology, arc lengths and re-root");
 	//addFlag ("whole", "Optimize whole topology, otherwise by subgraphs of radius " + toString (areaRadius_std));
 	  addKey ("subgraph_iter_max", "Max. number of iterations of subgraph optimizations over the whole tree; 0 - unlimited", "0");
+	  addKey ("subgraphs_memory_max", "Max. memory in GB used at the same time for the optimization of large subgraphs; larger trees are processed with smaller subgraphs and fewer threads; 0 - unlimited", "0");
 	  addFlag ("skip_len", "Skip length-only optimization");
 	  addFlag ("reinsert", "Reinsert subtrees before subgraph optimizations; works faster if hybrid objects have been removed");
 	//addFlag ("reinsert_orig_weights", "Use original weights in the reinsert optimization");  
 	  addFlag ("skip_topology", "Skip topology optimization");	  
 	  addFlag ("new_only", "Optimize only new objects in an incremental tree, implies not -optimize");  
+	  addKey ("checkpoint", "Binary file to save the state of -optimize after each step in");
+	  addFlag ("resume", "Resume -optimize from <checkpoint> saved for the same <data>, -variance and dissimilarity parameters; <input_tree> is not used");
 
 	  addFlag ("fix_discernible", "Set the indiscernible flag of objects");
 	  addFlag ("fix_transient", "Remove transient nodes (nodes with one child)");
@@ -121,6 +132,7 @@ struct ThisApplication final : Application
     // Output
 	  addFlag ("noqual", "Do not compute quality statistics");
 	  addKey ("output_tree", "Save the tesulting tree");
+	  addFlag ("output_tree_bin", "Also save <output_tree> in the binary format in the file <output_tree>" + DistTree::binSuff + ", which can be used as <input_tree>");
 	  addKey ("output_tree_tmp", "Save resulting trees after intermediary steps");
 	  addKey ("output_feature_tree", "Resulting tree in feature tree format");
 	  addFlag ("feature_tree_time", "Add arc time to <output_feature_tree>");
@@ -224,6 +236,7 @@ struct ThisApplication final : Application
 	  const string dataFName           = getArg ("data");
 	  const string dissimAttrName      = getArg ("dissim_attr");
 	  const string multAttrName        = getArg ("weight_attr");
+	  const bool   dissim_packed       = getFlag ("dissim_packed");
 	  const Real   dissim_power        = str2real (getArg ("dissim_power"));      
 	  const Real   dissim_coeff        = str2real (getArg ("dissim_coeff"));      
 	               varianceType        = str2varianceType (getArg ("variance"));  // Global
@@ -241,11 +254,14 @@ struct ThisApplication final : Application
 		const bool   optimize            = getFlag ("optimize");
 	//const bool   whole               = getFlag ("whole");
 		const size_t subgraph_iter_max   = str2<size_t> (getArg ("subgraph_iter_max"));
+		const Real   subgraphs_memory_max_gb = str2real (getArg ("subgraphs_memory_max"));
 		const bool   skip_len            = getFlag ("skip_len");
 		const bool   reinsert            = getFlag ("reinsert");
 	//const bool   reinsert_orig_weights = getFlag ("reinsert_orig_weights");		
 		const bool   skip_topology       = getFlag ("skip_topology");
 	  const bool   new_only            = getFlag ("new_only");
+	  const string checkpointFName     = getArg ("checkpoint");
+	  const bool   resume              = getFlag ("resume");
 
 	  const bool   fix_discernible     = getFlag ("fix_discernible");
 	  const bool   fix_transient       = getFlag ("fix_transient");
@@ -271,6 +287,7 @@ struct ThisApplication final : Application
 		const bool   noqual              = getFlag ("noqual");
 
 		const string output_tree         = getArg ("output_tree");
+		const bool   output_tree_bin     = getFlag ("output_tree_bin");
 		const string output_tree_tmp     = getArg ("output_tree_tmp");
 		const string output_dissim_coeff = getArg ("output_dissim_coeff");
 		const string output_feature_tree = getArg ("output_feature_tree");
@@ -298,6 +315,8 @@ struct ThisApplication final : Application
         throw runtime_error ("Dissimilarity attribute with no data file");
     if (dissimAttrName. empty () && ! multAttrName. empty ())
       throw runtime_error ("Dissimilarity weight attribute with no dissimilarity attribute");
+    if (dissim_packed && (dataFName. empty () || isDirName (dataFName)))
+      throw runtime_error ("-dissim_packed requires a " + dmSuff + "-file");
 
     if (dissim_coeff <= 0.0)
       throw runtime_error ("-dissim_coeff must be positive");
@@ -330,6 +349,9 @@ struct ThisApplication final : Application
       throw runtime_error ("-optimize requires dissimilarities");
     if (subgraph_iter_max && ! optimize)
       throw runtime_error ("-subgraph_iter_max requires -optimize");
+    if (subgraphs_memory_max_gb < 0.0)
+      throw runtime_error ("-subgraphs_memory_max cannot be negative");
+    subgraphs_memory_max = (size_t) (subgraphs_memory_max_gb * 1e9);  // Global
     if (skip_len && ! optimize)
       throw runtime_error ("-skip_len requires -optimize");
     if (reinsert && ! optimize)
@@ -340,6 +362,26 @@ struct ThisApplication final : Application
       throw runtime_error ("-skip_topology requires -optimize");
     if (new_only && optimize)
       throw runtime_error ("-new_only excludes -optimize");
+    if (! checkpointFName. empty ())
+    {
+      if (! optimize)
+        throw runtime_error ("-checkpoint requires -optimize");
+      if (isDirName (dataFName))
+        throw runtime_error ("-checkpoint excludes an incremental tree");
+      if (! deleteFName. empty () || ! keepFName. empty ())
+        throw runtime_error ("-checkpoint excludes -delete and -keep");
+      if (! delete_hybrids. empty ())
+        throw runtime_error ("-checkpoint excludes -delete_hybrids");
+    }
+    if (resume)
+    {
+      if (checkpointFName. empty ())
+        throw runtime_error ("-resume requires -checkpoint");
+      if (! fileExists (checkpointFName))
+        throw runtime_error ("Checkpoint file " + shellQuote (checkpointFName) + " does not exist");
+      if (! input_tree. empty ())
+        throw runtime_error ("-resume excludes -input_tree");
+    }
       
     if (fix_discernible && dataFName. empty ())
       throw runtime_error ("-fix_discernible requires dissimilarities");
@@ -372,6 +414,8 @@ struct ThisApplication final : Application
 		if (! isProb (arcExistence_min))
 		  throw runtime_error ("-arc_prob_min must be between 0 and 1");
 		  
+    if (output_tree_bin && output_tree. empty ())
+      throw runtime_error ("-output_tree_bin requires -output_tree");
     if (! output_dissim. empty () && ! optimizable)
       throw runtime_error ("-output_dissim requires dissimilarities");    	
     if (output_dist_etc && output_dissim. empty ())
@@ -390,17 +434,25 @@ struct ThisApplication final : Application
 
     const DissimParam dissimParam (dissim_power, dissim_coeff, hybridness_min, dissim_boundary);
     dissimParam. qc ();
+    
+    if (dissim_packed)
+      RealAttr2::packedObjs_min = 0;
 
     unique_ptr<DistTree> tree;
+    DistTree::Checkpoint checkpoint;
     {
       const Chronometer_OnePass cop ("Initial topology");  
-      tree. reset (isDirName (dataFName)
-                     ? new DistTree (dissimParam, dataFName, input_tree, true, true, new_only)
-                     : input_tree. empty ()
-                       ? new DistTree (dissimParam,             dataFName, dissimAttrName, multAttrName)
-                       : new DistTree (dissimParam, input_tree, dataFName, dissimAttrName, multAttrName)
+      tree. reset (resume
+                     ? new DistTree (dissimParam, checkpointFName, dataFName, dissimAttrName, multAttrName, checkpoint)
+                     : isDirName (dataFName)
+                       ? new DistTree (dissimParam, dataFName, input_tree, true, true, new_only)
+                       : input_tree. empty ()
+                         ? new DistTree (dissimParam,             dataFName, dissimAttrName, multAttrName)
+                         : new DistTree (dissimParam, input_tree, dataFName, dissimAttrName, multAttrName)
                   );
     }
+    if (resume)
+      cout << "Resuming after stage " << checkpoint. stage << ", iteration " << checkpoint. iter << endl;
     ASSERT (tree);
     tree->printParam (cout);
     cout << "Root: " << (root_topological ? "topological" : "by length") << endl;
@@ -413,7 +465,7 @@ struct ThisApplication final : Application
     
     ASSERT (optimizable == tree->optimizable ());
     
-    if (variance_dissim)
+    if (variance_dissim && ! resume)
     {
       if (tree->multFixed)
         throw runtime_error ("-variance_dissim cannot be used with fixed dissimilarity variance");
@@ -424,7 +476,7 @@ struct ThisApplication final : Application
       }
     }
     
-    if (fix_discernible)
+    if (fix_discernible && ! resume)
     {
       section ("Fixing discernible", false);
       tree->setDiscernibles ();
@@ -433,7 +485,7 @@ struct ThisApplication final : Application
       tree->setDissimMult (! multFixed_old. get ());
     }
     
-    if (fix_transient)
+    if (fix_transient && ! resume)
       tree->fixTransients ();
       
     if (! goodFName. empty ())
@@ -543,8 +595,17 @@ struct ThisApplication final : Application
           tree->saveFile (output_tree_tmp);  
 
           bool predictionImproved = false;
-
-          if (! skip_len)            
+          if (checkpoint. stage < stage_subgraphs)
+            predictionImproved = checkpoint. flags & checkpoint_predictionImproved;
+          const auto saveCheckpoint = [&tree, &checkpoint, &checkpointFName, &predictionImproved] (CheckpointStage stage,
+                                                                                                   size_t iter)
+            { checkpoint. stage = stage;
+              checkpoint. iter  = (uint32_t) iter;
+              checkpoint. flags = predictionImproved ? checkpoint_predictionImproved : 0;
+              tree->saveCheckpoint (checkpointFName, checkpoint);
+            };
+
+          if (! skip_len && checkpoint. stage < stage_len)
           {
             const Chronometer_OnePass cop ("Initial arc lengths");
 
@@ -572,10 +633,11 @@ struct ThisApplication final : Application
             
             if (lenArc_deleted || lenNode_deleted)
               predictionImproved = true;
+            saveCheckpoint (stage_len, 0);
           }
           
 
-          if (reinsert)
+          if (reinsert && checkpoint. stage < stage_reinsert)
           {
             section ("Optimizing topology: reinsert", true);
             const Chronometer_OnePass cop ("Topology optimization: reinsert");
@@ -587,6 +649,7 @@ struct ThisApplication final : Application
             tree->optimizeReinsert ();  
             tree->saveFile (output_tree_tmp); 
             predictionImproved = true;
+            saveCheckpoint (stage_reinsert, 0);
           }
           
           if (predictionImproved)
@@ -595,7 +658,7 @@ struct ThisApplication final : Application
             couterr << tree->absCriterion2str () << endl; 
          	}
           
-          if (! skip_topology)
+          if (! skip_topology && checkpoint. stage < stage_topology)
           {
             section ("Optimizing topology: subgraphs", true);
             const Chronometer_OnePass cop ("Topology optimization: local");
@@ -603,7 +666,7 @@ struct ThisApplication final : Application
             if (subgraph_iter_max)
             	minimize (iter_max, subgraph_iter_max);
             ASSERT (iter_max);
-            size_t iter = 0;
+            size_t iter = checkpoint. stage == stage_subgraphs ? checkpoint. iter : 0;
             while (iter < iter_max)
           	{
               section ("Iteration " + to_string (iter + 1) + ifS (iter_max < numeric_limits<size_t>::max (), " / " + to_string (iter_max)), true);
@@ -630,8 +693,11 @@ struct ThisApplication final : Application
               tree->setDissimMult (true);
               if (! tree->multFixed)
                 couterr << tree->absCriterion2str () << endl; 
+              saveCheckpoint (stage_subgraphs, iter);
             }
             cout << "# Iterations of subgraph optimization: " << iter << endl;
+            if (iter < iter_max)  // Converged
+              saveCheckpoint (stage_topology, iter);
             tree->reportErrors (cout);
           }
           
@@ -793,6 +859,8 @@ struct ThisApplication final : Application
     
     
     tree->saveFile (output_tree); 
+    if (output_tree_bin)
+      tree->saveBinFile (output_tree + DistTree::binSuff);
     tree->saveDissimCoeffs (output_dissim_coeff);
     tree->saveFeatureTree (output_feature_tree, feature_tree_time);
 
@@ -57,6 +57,7 @@ struct ThisApplication : Application
 	  // Input
 	  addPositional ("branch_prob", "Probability to expand a branch");
 	  addPositional ("leaf_num_max", "Max. number of leaves");
+	  addFlag ("benchmark", "Instead of printing the tree check that the tree and its CompactTree give the same results node by node and compare their memory and traversal time; the time is printed with -profile");
 	}
 
 
@@ -65,6 +66,7 @@ struct ThisApplication : Application
   {
 		const Real branch_prob    = str2<Prob> (getArg ("branch_prob"));
 		const size_t leaf_num_max = str2<size_t> (getArg ("leaf_num_max"));
+		const bool benchmark      = getFlag ("benchmark");
 		ASSERT (isProb (branch_prob));
 		ASSERT (branch_prob < 1.0);
 		ASSERT (branch_prob > 0.0);
@@ -73,8 +75,110 @@ struct ThisApplication : Application
 
     DistTree tree (branch_prob, leaf_num_max);
     tree. qc ();     
+    
+    if (benchmark)
+    {
+      Chronometer pointerLeaves ("Tree::setLeaves()");
+      pointerLeaves. start ();
+      tree. setLeaves ();
+      pointerLeaves. stop ();
+      Vector<size_t> leaves;  leaves. reserve (tree. nodes. size ());
+      
+      Chronometer pointerDists ("Root distances by Arc's");
+      pointerDists. start ();
+      Vector<pair<const DTNode*,Real>> dists;  dists. reserve (tree. nodes. size ());
+      {
+        Vector<pair<const DTNode*,Real>> stack;  stack. reserve (tree. nodes. size ());
+        stack << pair<const DTNode*,Real> (static_cast <const DTNode*> (tree. root), 0.0);
+        while (! stack. empty ())
+        {
+          const auto p = stack. pop ();
+          dists << p;
+          for (const DiGraph::Arc* arc : p. first->arcs [false])
+          {
+            const DTNode* child = static_cast <const DTNode*> (arc->node [false]);
+            stack << pair<const DTNode*,Real> (child, p. second + child->len);
+          }
+        }
+      }
+      pointerDists. stop ();
+      
+      Chronometer compactInit ("CompactTree()");
+      compactInit. start ();
+      const CompactTree ct (tree);
+      compactInit. stop ();
+      ct. qc ();
+      
+      for (const Tree::TreeNode* node : ct. nodes)
+        leaves << node->leaves;
+      Chronometer compactLeaves ("CompactTree::setLeaves()");
+      compactLeaves. start ();
+      ct. setLeaves ();
+      compactLeaves. stop ();
+      FFOR (size_t, i, ct. nodes. size ())
+        QC_ASSERT (ct. nodes [i] -> leaves == leaves [i]);
+      
+      Chronometer compactDists ("CompactTree::getRootDistances()");
+      compactDists. start ();
+      const Vector<double> compactDists_ (ct. getRootDistances ());
+      compactDists. stop ();
+      QC_ASSERT (compactDists_. size () == dists. size ());
+      constexpr Real distEpsilon = 1e-9;  // PAR
+      for (const auto& p : dists)
+      {
+        const Real compactDist = compactDists_ [ct. getIndex (p. first)];
+        if (abs (compactDist - p. second) > distEpsilon * max (1.0, abs (p. second)))
+          throw runtime_error ("CompactTree::getRootDistances() = " + toString (compactDist) + " != " + toString (p. second) + " by Arc's");
+      }
+      
+      Chronometer lcaInit ("TreeLca()");
+      lcaInit. start ();
+      const TreeLca lcaIndex (tree);
+      lcaInit. stop ();
+      lcaIndex. qc ();
+      
+      constexpr size_t lcaPairs = 1000000;  // PAR
+      Vector<Pair<const Tree::TreeNode*>> pairs;  pairs. reserve (lcaPairs);
+      {
+        Rand rand (seed_global);
+        FOR (size_t, i, lcaPairs)
+          pairs << Pair<const Tree::TreeNode*> ( lcaIndex. ct. nodes [rand. get ((ulong) lcaIndex. ct. size ())]
+                                               , lcaIndex. ct. nodes [rand. get ((ulong) lcaIndex. ct. size ())]
+                                               );
+      }
+      VectorPtr<Tree::TreeNode> lcas;  lcas. reserve (lcaPairs);
+      Chronometer pointerLca ("Tree::getLca()");
+      pointerLca. start ();
+      {
+        Tree::LcaBuffer buf;
+        for (const auto& p : pairs)
+          lcas << Tree::getLca (p. first, p. second, buf);
+      }
+      pointerLca. stop ();
+      Chronometer compactLca ("TreeLca::getLca()");
+      compactLca. start ();
+      FFOR (size_t, i, pairs. size ())
+        if (lcaIndex. getLca (pairs [i]. first, pairs [i]. second) != lcas [i])
+          throw runtime_error ("TreeLca::getLca() != Tree::getLca()");
+      compactLca. stop ();
       
-    tree. saveText (cout);
+      const size_t n = tree. nodes. size ();
+      const size_t listNode = 3 * sizeof (void*);
+      cout << "Nodes: " << n << endl;
+      cout << "Leaves: " << tree. root->leaves << endl;
+      cout << "Arc-based topology, bytes: " << n * listNode + (n - 1) * (sizeof (DiGraph::Arc) + 2 * listNode) << endl;
+      cout << "CompactTree, bytes: " << ct. getMemory () << endl;
+      pointerLeaves. print (cout);
+      compactLeaves. print (cout);
+      pointerDists. print (cout);
+      compactDists. print (cout);
+      compactInit. print (cout);
+      pointerLca. print (cout);
+      compactLca. print (cout);
+      lcaInit. print (cout);
+    }
+    else
+      tree. saveText (cout);
 	}
 };
 
@@ -302,16 +302,17 @@ struct ThisApplication : Application
         	}
         }
         
-      	Tree::LcaBuffer buf;
+        const TreeLca lcaIndex (tree);
+        const Vector<double> rootDists (lcaIndex. ct. getRootDistances ());
       	for (const auto& p : distRequestPairs)
       	{
       		const Leaf* leaf1 = p. first;
       		const Leaf* leaf2 = p. second;
-  			  const Tree::TreeNode* lca_ = nullptr;
-  	    	const VectorPtr<Tree::TreeNode>& path = Tree::getPath (leaf1, leaf2, nullptr, lca_, buf);
+      		const TreeLca::Index i1 = lcaIndex. ct. getIndex (leaf1);
+      		const TreeLca::Index i2 = lcaIndex. ct. getIndex (leaf2);
   		  	outF      << leaf1->name 
   		  	  << '\t' << leaf2->name
-  		  	  << '\t' << DistTree::path2prediction (path)
+  		  	  << '\t' << rootDists [i1] + rootDists [i2] - 2.0 * rootDists [lcaIndex. getLca (i1, i2)]
   		  	  << '\n';
   		  }
       }
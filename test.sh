@@ -14,6 +14,9 @@ super_section "kmerIndex"
 # Time: 18 sec.
 $THIS/genetics/kmerIndex_test.sh go
 
+super_section "hash dissimilarities"
+$THIS/dissim/hash_test.sh go
+
 super_section "distTree"
 # Time: 75 (63) min.
 time $THIS/phylogeny/distTree_test.sh go